@@ -0,0 +1,63 @@
+/**
+ * @file fixed_point_divisor.hpp
+ * @brief Делитель FixedPoint с заранее вычисленным обратным
+ */
+
+#ifndef FIXED_POINT_DIVISOR_H
+#define FIXED_POINT_DIVISOR_H
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "../include/long_arithmetic.hpp"
+
+/**
+ * @class FixedPointDivisor
+ * @brief Делитель для многократного деления на одно и то же число
+ *
+ * При создании делитель нормализуется и для него вычисляется обратное:
+ * для однолимбового делителя - по Мёллеру - Гранлунду, для длинного
+ * многолимбового - floor(B^(2n) / d) для редукции Барретта. После этого каждое деление
+ * обходится без нормализации делителя и аппаратного деления на каждую
+ * цифру частного. Результаты совпадают с operator/ и divide_with_remainder.
+ */
+class FixedPointDivisor {
+public:
+    /**
+     * @brief Подготавливает делитель
+     * @param divisor Делитель
+     * @throw std::runtime_error если делитель равен нулю
+     */
+    explicit FixedPointDivisor(const FixedPoint &divisor);
+
+    /**
+     * @brief Деление на подготовленный делитель
+     * @param dividend Делимое
+     * @return То же, что dividend / divisor
+     */
+    FixedPoint divide(const FixedPoint &dividend) const;
+
+    /**
+     * @brief Деление с остатком на подготовленный делитель
+     * @param dividend Делимое
+     * @return То же, что dividend.divide_with_remainder(divisor)
+     */
+    std::pair<FixedPoint, FixedPoint> divmod(const FixedPoint &dividend) const;
+
+private:
+    FixedPoint divisor;                 ///< Исходный делитель
+    std::vector<uint32_t> normalized;   ///< Склеенные лимбы делителя, сдвинутые до старшего бита
+    unsigned shift = 0;                 ///< Сдвиг нормализации в битах
+    uint32_t limb_inverse = 0;          ///< Обратное к однолимбовому делителю
+    std::vector<uint32_t> inverse;      ///< Обратное к многолимбовому делителю (vn + 1 лимбов)
+
+    /**
+     * @brief Целочисленное частное склеенных лимбов на склеенные лимбы делителя
+     * @param dividend Лимбы делимого, младший первым
+     * @return Частное той же длины, что и делимое
+     */
+    LimbBuffer quotient_limbs(const LimbBuffer &dividend) const;
+};
+
+#endif // FIXED_POINT_DIVISOR_H
@@ -0,0 +1,176 @@
+/**
+ * @file limb_buffer.hpp
+ * @brief Буфер лимбов со встроенным хранилищем для коротких чисел
+ */
+
+#ifndef LIMB_BUFFER_H
+#define LIMB_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+/**
+ * @brief Ресурс памяти, из которого создаются новые буферы лимбов в этом потоке
+ * @return По умолчанию std::pmr::new_delete_resource(), внутри
+ * LimbResourceScope - ресурс области
+ */
+std::pmr::memory_resource *limb_resource();
+
+/**
+ * @brief Пул буферов лимбов по классам размеров, свой для каждого потока
+ * @details Освобождённые блоки возвращаются в пул и переиспользуются без
+ * обращения к malloc. Пул не синхронизирован: числа, память которых взята
+ * из пула, должны уничтожаться в том же потоке.
+ */
+std::pmr::memory_resource *limb_pool();
+
+/**
+ * @class LimbArena
+ * @brief Арена для буферов лимбов: выделение сдвигом указателя, освобождение разом
+ *
+ * Отдельные буферы не освобождаются, вся память возвращается при
+ * уничтожении арены. Подходит для одного вычисления с множеством
+ * промежуточных чисел, например get_pi(). Числа из арены не должны
+ * переживать её.
+ */
+class LimbArena : public std::pmr::monotonic_buffer_resource {
+public:
+    /**
+     * @brief Создаёт арену
+     * @param initial_bytes Размер первого блока, следующие блоки растут геометрически
+     */
+    explicit LimbArena(size_t initial_bytes = 64 * 1024)
+        : std::pmr::monotonic_buffer_resource(initial_bytes, std::pmr::new_delete_resource()) {}
+};
+
+/**
+ * @class LimbResourceScope
+ * @brief Задаёт ресурс памяти для буферов лимбов, создаваемых в текущем потоке
+ *
+ * Действует до уничтожения объекта, после чего восстанавливается прежний
+ * ресурс. Области могут быть вложенными.
+ * @code{.cpp}
+ * LimbArena arena;
+ * LimbResourceScope scope(&arena);
+ * FixedPoint x = a * b + c; // лимбы x и временных значений - из арены
+ * @endcode
+ */
+class LimbResourceScope {
+public:
+    explicit LimbResourceScope(std::pmr::memory_resource *resource);
+    ~LimbResourceScope();
+
+    LimbResourceScope(const LimbResourceScope &) = delete;
+    LimbResourceScope &operator=(const LimbResourceScope &) = delete;
+
+private:
+    std::pmr::memory_resource *previous; ///< Ресурс, действовавший до области
+};
+
+/**
+ * @class LimbBuffer
+ * @brief Непрерывный массив 32-битных лимбов с оптимизацией малых размеров
+ *
+ * Первые INLINE_LIMBS лимбов хранятся внутри самого объекта, поэтому
+ * короткие числа (счётчики, константы, временные значения CalcPi) создаются,
+ * копируются и складываются без обращения к куче. При превышении ёмкости
+ * данные переносятся в динамическую память, ёмкость растёт вдвое.
+ * Новые лимбы, добавляемые resize и insert_zeros, заполняются нулями.
+ *
+ * Динамическая память берётся из ресурса limb_resource(), действовавшего
+ * при создании буфера, и всегда возвращается в него же. Как и у контейнеров
+ * std::pmr, перемещающий конструктор забирает ресурс вместе с данными, а
+ * перемещающее присваивание при разных ресурсах копирует лимбы.
+ */
+class LimbBuffer {
+public:
+    /// Количество лимбов во встроенном хранилище
+    static constexpr size_t INLINE_LIMBS = 16;
+
+    LimbBuffer() = default;
+
+    /**
+     * @brief Создаёт буфер из count нулевых лимбов
+     */
+    explicit LimbBuffer(size_t count);
+
+    /**
+     * @brief Создаёт буфер из лимбов [first, last)
+     */
+    LimbBuffer(const uint32_t *first, const uint32_t *last);
+
+    LimbBuffer(const LimbBuffer &other);
+    LimbBuffer(LimbBuffer &&other) noexcept;
+    LimbBuffer &operator=(const LimbBuffer &other);
+    LimbBuffer &operator=(LimbBuffer &&other) noexcept;
+    ~LimbBuffer();
+
+    uint32_t *data() { return ptr; }
+    const uint32_t *data() const { return ptr; }
+    size_t size() const { return count; }
+    size_t capacity() const { return cap; }
+    bool empty() const { return count == 0; }
+    bool is_inline() const { return ptr == inline_limbs; }
+    std::pmr::memory_resource *get_resource() const { return resource; }
+
+    uint32_t &operator[](size_t i) { return ptr[i]; }
+    const uint32_t &operator[](size_t i) const { return ptr[i]; }
+    uint32_t &back() { return ptr[count - 1]; }
+    const uint32_t &back() const { return ptr[count - 1]; }
+
+    uint32_t *begin() { return ptr; }
+    const uint32_t *begin() const { return ptr; }
+    uint32_t *end() { return ptr + count; }
+    const uint32_t *end() const { return ptr + count; }
+
+    /**
+     * @brief Заменяет содержимое лимбами [first, last)
+     * @details Диапазон не должен указывать внутрь самого буфера
+     */
+    void assign(const uint32_t *first, const uint32_t *last);
+
+    /**
+     * @brief Меняет размер, новые лимбы равны нулю
+     */
+    void resize(size_t new_size);
+
+    /**
+     * @brief Резервирует место под new_cap лимбов
+     */
+    void reserve(size_t new_cap);
+
+    /**
+     * @brief Добавляет лимб в конец
+     */
+    void push_back(uint32_t value);
+
+    /**
+     * @brief Вставляет zeros нулевых лимбов в начало
+     */
+    void insert_zeros(size_t zeros);
+
+    /**
+     * @brief Очищает буфер, не освобождая память
+     */
+    void clear() { count = 0; }
+
+private:
+    uint32_t inline_limbs[INLINE_LIMBS]; ///< Встроенное хранилище
+    uint32_t *ptr = inline_limbs;        ///< Начало данных: inline_limbs или память в куче
+    size_t count = 0;                    ///< Количество лимбов
+    size_t cap = INLINE_LIMBS;           ///< Ёмкость
+    std::pmr::memory_resource *resource = limb_resource(); ///< Источник динамической памяти
+
+    /**
+     * @brief Переносит данные в кучу с ёмкостью не меньше min_cap
+     */
+    void grow(size_t min_cap);
+
+    /**
+     * @brief Возвращает динамическую память в ресурс
+     */
+    void release();
+};
+
+#endif // LIMB_BUFFER_H
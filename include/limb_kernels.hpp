@@ -0,0 +1,495 @@
+/**
+ * @file limb_kernels.hpp
+ * @brief Низкоуровневые операции над массивами 32-битных лимбов
+ *
+ * Число представлено массивом лимбов, младший лимб идёт первым. Именно в
+ * таком виде FixedPoint хранит в одном буфере лимбы дробной и целой частей,
+ * поэтому ядра работают напрямую с его данными.
+ */
+
+#ifndef LIMB_KERNELS_H
+#define LIMB_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace limbs {
+
+using limb_t = uint32_t;   ///< Один разряд числа (лимб)
+using dlimb_t = uint64_t;  ///< Двойной лимб для накопления произведений
+
+/// Приёмник десятичных цифр: получает очередной блок (указатель и длину)
+using DigitSink = std::function<void(const char *, size_t)>;
+
+/**
+ * @brief Размер блока множителя (в лимбах) при умножении столбиком
+ *
+ * Блок множителя и соответствующее окно результата (по 8 КБ) вместе
+ * помещаются в кэш L1, поэтому строки произведения не вытесняют друг друга.
+ */
+constexpr size_t MUL_BLOCK_LIMBS = 2048;
+
+/// @name Пороги выбора алгоритма умножения (по длине меньшего операнда, в лимбах)
+/// @{
+constexpr size_t KARATSUBA_THRESHOLD = 40;  ///< Начиная с этой длины - Карацуба
+constexpr size_t TOOM3_THRESHOLD = 800;     ///< Начиная с этой длины - Тоом-3
+constexpr size_t TOOM4_THRESHOLD = 2400;    ///< Начиная с этой длины - Тоом-4
+constexpr size_t NTT_THRESHOLD = 8000;      ///< Начиная с этой длины - NTT
+
+/// Порог Карацубы для возведения в квадрат: квадрат столбиком вдвое дешевле умножения
+constexpr size_t SQR_KARATSUBA_THRESHOLD = 64;
+/// @}
+
+/// @name Пороги выбора алгоритма деления (в лимбах)
+/// @{
+/// Начиная с этой длины делителя и частного - рекурсивное деление Буркинеля - Циглера
+constexpr size_t DIV_BZ_THRESHOLD = 40;
+/// Начиная с этой длины делителя и частного - умножение на обратное
+constexpr size_t DIV_NEWTON_THRESHOLD = 80000;
+/// Начиная с этой длины обратное вычисляется итерацией Ньютона
+constexpr size_t INV_NEWTON_THRESHOLD = 400;
+/// Начиная с этой длины FixedPointDivisor делит умножением на обратное, а не рекурсивно
+constexpr size_t DIV_PREINV_THRESHOLD = 4000;
+/// @}
+
+/// @name Пороги перевода между десятичной и двоичной системами
+/// @{
+/// Начиная с этого количества цифр строка переводится делением пополам
+constexpr size_t SET_STR_DC_THRESHOLD = 1000;
+/// Начиная с этой длины (в лимбах) число переводится в десятичную запись делением пополам
+constexpr size_t GET_STR_DC_THRESHOLD = 40;
+/// Размер блока, которым write_str передаёт цифры
+constexpr size_t DIGIT_BLOCK_SIZE = 64 * 1024;
+/// Сколько цифр дроби сверх необходимых для точности переводится до проверки хвоста
+constexpr size_t FRAC_GUARD_DIGITS = 20;
+/// @}
+
+/// Наибольшая суммарная длина операндов, при которой NTT по трём модулям точна
+constexpr size_t NTT_MAX_LIMBS = size_t(1) << 26;
+
+/**
+ * @brief Сложение массивов одинаковой длины: r = a + b
+ * @param r Результат (n лимбов), может совпадать с a или b
+ * @return Перенос из старшего лимба
+ */
+limb_t add_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+
+/**
+ * @brief Вычитание массивов одинаковой длины: r = a - b
+ * @param r Результат (n лимбов), может совпадать с a или b
+ * @return Заём из старшего лимба
+ */
+limb_t sub_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+
+/**
+ * @brief Сложение массивов разной длины: r = a + b, an >= bn
+ * @param r Результат (an лимбов), может совпадать с a
+ * @return Перенос из старшего лимба
+ */
+limb_t add(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn);
+
+/**
+ * @brief Вычитание массивов разной длины: r = a - b, an >= bn
+ * @param r Результат (an лимбов), может совпадать с a
+ * @return Заём из старшего лимба
+ */
+limb_t sub(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn);
+
+/**
+ * @brief Прибавляет лимб к массиву: r = a + b
+ * @return Перенос из старшего лимба
+ */
+limb_t add_1(limb_t *r, const limb_t *a, size_t n, limb_t b);
+
+/**
+ * @brief Вычитает лимб из массива: r = a - b
+ * @return Заём из старшего лимба
+ */
+limb_t sub_1(limb_t *r, const limb_t *a, size_t n, limb_t b);
+
+/**
+ * @brief Сравнивает массивы одинаковой длины
+ * @return -1, 0 или 1, если a < b, a == b или a > b
+ */
+int cmp(const limb_t *a, const limb_t *b, size_t n);
+
+/**
+ * @brief Длина массива без старших нулевых лимбов
+ */
+size_t normalized_size(const limb_t *a, size_t n);
+
+/**
+ * @brief Обратное к нормализованному лимбу: floor((B^2 - 1) / d) - B, B = 2^32
+ * @param d Делитель со старшим установленным битом
+ */
+limb_t invert_limb(limb_t d);
+
+/**
+ * @brief Делит массив на лимб с заранее вычисленным обратным
+ * @param q Частное (n лимбов), может совпадать с a
+ * @param a Делимое (n лимбов)
+ * @param n Количество лимбов
+ * @param d Нормализованный делитель: исходный делитель, сдвинутый влево на shift бит
+ * @param dinv Обратное к d (invert_limb)
+ * @param shift Сдвиг нормализации
+ * @return Остаток от деления на исходный делитель
+ *
+ * @details Каждая цифра частного получается двумя умножениями и не более
+ * чем двумя исправлениями (алгоритм Мёллера - Гранлунда) вместо аппаратного
+ * деления.
+ */
+limb_t divmod_1_preinv(limb_t *q, const limb_t *a, size_t n, limb_t d, limb_t dinv, unsigned shift);
+
+/**
+ * @brief Делит массив на один лимб: q = a / d
+ * @param q Частное (n лимбов), может совпадать с a
+ * @param a Делимое (n лимбов)
+ * @param n Количество лимбов
+ * @param d Делитель, не равен нулю
+ * @return Остаток от деления
+ *
+ * @details Нормализует d, вычисляет обратное и вызывает divmod_1_preinv.
+ */
+limb_t divmod_1(limb_t *q, const limb_t *a, size_t n, limb_t d);
+
+/**
+ * @brief Делит массив на число из двух лимбов: q = a / d
+ * @param q Частное (n лимбов), может совпадать с a
+ * @param d Делитель, не равен нулю
+ * @return Остаток от деления
+ */
+dlimb_t divmod_2(limb_t *q, const limb_t *a, size_t n, dlimb_t d);
+
+/**
+ * @brief Делит массив на лимб, когда деление заведомо без остатка: q = a / d
+ * @param q Частное (n лимбов), может совпадать с a
+ * @param d Делитель, не равен нулю
+ *
+ * @details Вместо аппаратного деления умножает на обратный к нечётной
+ * части d по модулю 2^32, степень двойки снимается сдвигом.
+ */
+void divexact_1(limb_t *q, const limb_t *a, size_t n, limb_t d);
+
+/**
+ * @brief Сдвиг массива влево на cnt бит: r = a << cnt, 0 < cnt < 32
+ * @param r Результат (n лимбов), может совпадать с a
+ * @return Выдвинутые за старший лимб биты
+ */
+limb_t lshift(limb_t *r, const limb_t *a, size_t n, unsigned cnt);
+
+/**
+ * @brief Сдвиг массива вправо на cnt бит: r = a >> cnt, 0 < cnt < 32
+ * @param r Результат (n лимбов), может совпадать с a
+ * @return Выдвинутые за младший лимб биты в старших разрядах лимба
+ */
+limb_t rshift(limb_t *r, const limb_t *a, size_t n, unsigned cnt);
+
+/**
+ * @brief Умножает массив на один лимб: r = a * b
+ * @param r Результат (n лимбов), может совпадать с a
+ * @param a Множитель (n лимбов)
+ * @param n Количество лимбов
+ * @param b Лимб-множитель
+ * @return Старший лимб (перенос) произведения
+ */
+limb_t mul_1(limb_t *r, const limb_t *a, size_t n, limb_t b);
+
+/**
+ * @brief Прибавляет к массиву произведение массива на лимб: r += a * b
+ * @param r Аккумулятор (n лимбов)
+ * @param a Множитель (n лимбов)
+ * @param n Количество лимбов
+ * @param b Лимб-множитель
+ * @return Перенос из старшего лимба
+ */
+limb_t addmul_1(limb_t *r, const limb_t *a, size_t n, limb_t b);
+
+/**
+ * @brief Вычитает из массива произведение массива на лимб: r -= a * b
+ * @param r Уменьшаемое (n лимбов)
+ * @param a Множитель (n лимбов)
+ * @param n Количество лимбов
+ * @param b Лимб-множитель
+ * @return Заём из старшего лимба
+ */
+limb_t submul_1(limb_t *r, const limb_t *a, size_t n, limb_t b);
+
+/**
+ * @brief Умножение столбиком с разбиением множителя на блоки под L1
+ * @param r Результат (an + bn лимбов), не должен пересекаться с a и b
+ * @param a Первый множитель (an лимбов)
+ * @param an Длина первого множителя
+ * @param b Второй множитель (bn лимбов)
+ * @param bn Длина второго множителя
+ */
+void mul_basecase(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn);
+
+/**
+ * @brief Умножение Карацубы (вычитательный вариант)
+ * @param r Результат (an + bn лимбов), не должен пересекаться с a и b
+ *
+ * @details Требует an >= bn > ceil(an / 2). Подпроизведения вычисляются
+ * через limbs::mul, поэтому рекурсия сама переходит на нужный уровень.
+ */
+void mul_karatsuba(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn);
+
+/**
+ * @brief Умножение Тоома-3: разбиение на 3 части, 5 точек интерполяции
+ * @param r Результат (an + bn лимбов), не должен пересекаться с a и b
+ *
+ * @details Требует an >= bn > an / 2.
+ */
+void mul_toom3(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn);
+
+/**
+ * @brief Умножение Тоома-4: разбиение на 4 части, 7 точек интерполяции
+ * @param r Результат (an + bn лимбов), не должен пересекаться с a и b
+ *
+ * @details Требует an >= bn > an / 2.
+ */
+void mul_toom4(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn);
+
+/**
+ * @brief Умножение через NTT по трём простым модулям с восстановлением по КТО
+ * @param r Результат (an + bn лимбов), не должен пересекаться с a и b
+ *
+ * @details Работает за O(n log n) при любом соотношении длин операндов,
+ * требует an + bn <= NTT_MAX_LIMBS.
+ */
+void mul_ntt(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn);
+
+/**
+ * @brief Квадрат столбиком: r = a^2
+ * @param r Результат (2n лимбов), не должен пересекаться с a
+ *
+ * @details Каждое произведение a[i] * a[j] при i != j вычисляется один раз
+ * и удваивается сдвигом, затем добавляются квадраты a[i]^2 на диагонали.
+ */
+void sqr_basecase(limb_t *r, const limb_t *a, size_t n);
+
+/**
+ * @brief Квадрат по Карацубе: три рекурсивных квадрата вместо трёх произведений
+ * @param r Результат (2n лимбов), не должен пересекаться с a
+ */
+void sqr_karatsuba(limb_t *r, const limb_t *a, size_t n);
+
+/**
+ * @brief Квадрат по Тоому-3: значения в точках вычисляются один раз и возводятся в квадрат
+ * @param r Результат (2n лимбов), не должен пересекаться с a
+ */
+void sqr_toom3(limb_t *r, const limb_t *a, size_t n);
+
+/**
+ * @brief Квадрат по Тоому-4
+ * @param r Результат (2n лимбов), не должен пересекаться с a
+ */
+void sqr_toom4(limb_t *r, const limb_t *a, size_t n);
+
+/**
+ * @brief Квадрат через NTT: одно прямое преобразование на модуль вместо двух
+ * @param r Результат (2n лимбов), не должен пересекаться с a
+ *
+ * @details Требует 2n <= NTT_MAX_LIMBS.
+ */
+void sqr_ntt(limb_t *r, const limb_t *a, size_t n);
+
+/**
+ * @brief Возведение в квадрат числа произвольной длины: r = a^2
+ * @param r Результат (2n лимбов), не должен пересекаться с a
+ *
+ * @details Выбирает алгоритм по длине так же, как limbs::mul.
+ */
+void sqr(limb_t *r, const limb_t *a, size_t n);
+
+/**
+ * @brief Умножение двух чисел произвольной длины: r = a * b
+ * @param r Результат (an + bn лимбов), не должен пересекаться с a и b
+ * @param a Первый множитель (an лимбов)
+ * @param an Длина первого множителя
+ * @param b Второй множитель (bn лимбов)
+ * @param bn Длина второго множителя
+ *
+ * @details Точка входа для FixedPoint::operator*, выбирает алгоритм по длине
+ * операндов. Если a и b - один и тот же массив, вызывает limbs::sqr.
+ */
+void mul(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn);
+
+/**
+ * @brief Деление столбиком по лимбам (алгоритм D Кнута)
+ * @param q Частное (un - vn лимбов)
+ * @param u Делимое (un лимбов), на выходе младшие vn лимбов - остаток
+ * @param un Длина делимого, un > vn
+ * @param v Нормализованный делитель (vn >= 2 лимбов, старший бит установлен)
+ * @param vn Длина делителя
+ *
+ * @details Требует, чтобы старшие vn лимбов делимого были меньше v. Каждая
+ * цифра частного оценивается делением двух старших лимбов остатка на
+ * старший лимб делителя, уточняется по второму лимбу и исправляется не
+ * более чем одним обратным сложением.
+ */
+void div_basecase(limb_t *q, limb_t *u, size_t un, const limb_t *v, size_t vn);
+
+/**
+ * @brief Обратное к нормализованному числу: x = floor(B^(2n) / v), B = 2^32
+ * @param x Результат (n + 1 лимбов)
+ * @param v Нормализованное число (n лимбов, старший бит установлен)
+ * @param n Длина v
+ *
+ * @details Обратное к старшей половине v вычисляется рекурсивно, затем
+ * один шаг Ньютона удваивает его точность. Оставшаяся ошибка в несколько
+ * единиц исправляется по точному остатку B^(2n) - v * x.
+ */
+void invert(limb_t *x, const limb_t *v, size_t n);
+
+/**
+ * @brief Деление умножением на обратное к делителю
+ *
+ * @details Тот же контракт, что у div_basecase. Частное вычисляется блоками
+ * по vn лимбов: оценка блока - произведение старших лимбов остатка на
+ * обратное к делителю, затем несколько исправлений по остатку.
+ */
+void div_newton(limb_t *q, limb_t *u, size_t un, const limb_t *v, size_t vn);
+
+/**
+ * @brief Рекурсивное деление Буркинеля - Циглера
+ *
+ * @details Тот же контракт, что у div_basecase, требует vn >= 4. Частное
+ * вычисляется блоками по vn лимбов, каждый блок - рекурсивным делением
+ * 2vn лимбов на vn, поэтому время пропорционально умножению длины vn
+ * на число блоков.
+ */
+void div_dc(limb_t *q, limb_t *u, size_t un, const limb_t *v, size_t vn);
+
+/**
+ * @brief Деление с заранее вычисленным обратным к делителю (редукция Барретта)
+ * @param x Обратное к v: floor(B^(2vn) / v), vn + 1 лимбов (limbs::invert)
+ *
+ * @details Тот же контракт, что у div_basecase. Каждый блок частного из
+ * vn лимбов стоит двух умножений и нескольких исправлений, поэтому при
+ * многократном делении на одно число обратное вычисляется один раз.
+ */
+void div_preinv(limb_t *q, limb_t *u, size_t un, const limb_t *v, size_t vn, const limb_t *x);
+
+/**
+ * @brief Деление с остатком чисел произвольной длины: q = a / d, r = a mod d
+ * @param q Частное (an - dn + 1 лимбов), не должно пересекаться с a и d
+ * @param r Остаток (dn лимбов) или nullptr, если остаток не нужен
+ * @param a Делимое (an лимбов), an >= dn
+ * @param an Длина делимого
+ * @param d Делитель (dn лимбов), старший лимб не равен нулю
+ * @param dn Длина делителя
+ *
+ * @details Точка входа для FixedPoint::operator/: нормализует делитель
+ * сдвигом и выбирает алгоритм по длине операндов.
+ */
+void divrem(limb_t *q, limb_t *r, const limb_t *a, size_t an, const limb_t *d, size_t dn);
+
+/**
+ * @brief Оценка сверху длины в лимбах числа из n десятичных цифр
+ */
+size_t set_str_limbs(size_t n);
+
+/**
+ * @brief Переводит строку десятичных цифр в массив лимбов
+ * @param r Результат, не меньше set_str_limbs(n) лимбов
+ * @param digits Цифры '0'-'9', старшая первой, без знака и точки
+ * @param n Количество цифр
+ * @return Длина результата без старших нулевых лимбов (0 для нуля);
+ * лимбы r за ней не определены
+ *
+ * @details Строки короче SET_STR_DC_THRESHOLD цифр переводятся блоками по
+ * 9 цифр, длинные - рекурсивно с умножением на степени 10^(9 * 2^k) из
+ * кэша потока.
+ */
+size_t set_str(limb_t *r, const char *digits, size_t n);
+
+/**
+ * @brief Переводит десятичную дробь 0.d1...dn в rn лимбов: r = floor(N * B^rn / 10^n)
+ * @param r Результат (rn лимбов), старший лимб - первые 32 бита дроби
+ * @param rn Количество лимбов результата
+ * @param digits Цифры дроби после точки, N - целое из них
+ * @param n Количество цифр
+ *
+ * @details Результат совпадает с умножением дроби на 2 по одному биту с
+ * усечением. Переводятся только первые цифры, влияющие на rn лимбов, и
+ * FRAC_GUARD_DIGITS запасных; остальные учитываются, только если могут
+ * изменить результат.
+ */
+void set_frac_str(limb_t *r, size_t rn, const char *digits, size_t n);
+
+/**
+ * @brief Оценка сверху количества десятичных цифр числа из n лимбов
+ */
+size_t get_str_digits(size_t n);
+
+/**
+ * @brief Переводит массив лимбов в строку десятичных цифр
+ * @param out Буфер не короче get_str_digits(n) символов
+ * @param a Число (n лимбов)
+ * @param n Длина числа
+ * @return Количество цифр без ведущих нулей (0 для нуля); символы out за
+ * ними не определены
+ *
+ * @details Числа короче GET_STR_DC_THRESHOLD лимбов переводятся блоками по
+ * 9 цифр, длинные - делением на степени 10^(9 * 2^k) из кэша потока.
+ */
+size_t get_str(char *out, const limb_t *a, size_t n);
+
+/**
+ * @brief Точное количество десятичных цифр числа a (n лимбов), для нуля - 0
+ * @details Оценивается по длине в битах и уточняется сравнением со
+ * степенью десяти из кэша потока; числа до двух лимбов - без длинной
+ * арифметики.
+ */
+size_t decimal_digits(const limb_t *a, size_t n);
+
+/**
+ * @brief Переводит число a < 10^digits ровно в digits цифр, дополняя нулями слева
+ * @param out Буфер из digits символов
+ */
+void get_str_padded(char *out, size_t digits, const limb_t *a, size_t n);
+
+/**
+ * @brief Записывает число в десятичной записи блоками по мере перевода
+ * @param sink Получает цифры блоками не длиннее DIGIT_BLOCK_SIZE, старшие первыми
+ * @param a Число (n лимбов), для нуля ничего не выводится
+ * @param n Длина числа
+ *
+ * @details Тот же перевод, что у get_str, но цифры не собираются в одну
+ * строку: сверх самого числа нужны один блок и частные и остатки по пути
+ * рекурсии.
+ */
+void write_str(const DigitSink &sink, const limb_t *a, size_t n);
+
+/**
+ * @brief Записывает ровно digits цифр числа a < 10^digits, дополняя нулями слева
+ * @param sink Получает цифры блоками не длиннее DIGIT_BLOCK_SIZE, старшие первыми
+ */
+void write_str_padded(const DigitSink &sink, size_t digits, const limb_t *a, size_t n);
+
+/**
+ * @brief Размер массива для frac_digits с m цифрами
+ */
+size_t frac_digits_limbs(size_t m);
+
+/**
+ * @brief Первые m десятичных цифр дроби f / B^fn как целое число
+ * @param r Результат, frac_digits_limbs(m) лимбов: floor(f * 10^m / B^fn),
+ * а при round - floor(f * 10^m / B^fn + 1/2)
+ * @param m Количество цифр
+ * @param f Дробь (fn лимбов), старший лимб - первые 32 бита после точки
+ * @param fn Длина дроби
+ * @param round Округлять половиной вверх вместо усечения
+ * @return true, если округление дало 10^m: тогда r = 0, а единица
+ * переносится в целую часть
+ *
+ * @details Читаются только старшие лимбы f, нужные для m цифр, поэтому
+ * время зависит от m, а не от длины дроби. Цифры - это r, дополненное
+ * нулями до m знаков (get_str_padded, write_str_padded).
+ */
+bool frac_digits(limb_t *r, size_t m, const limb_t *f, size_t fn, bool round);
+
+} // namespace limbs
+
+#endif // LIMB_KERNELS_H
@@ -8,8 +8,16 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include <charconv>
+#include <iosfwd>
 #include <cstdint>
 #include <utility>
+#include <type_traits>
+#include <functional>
+#include <initializer_list>
+
+#include "../include/limb_buffer.hpp"
 
 /**
  * @enum Op_behavior
@@ -30,6 +38,18 @@ enum class Op_behavior {
  * для чисел с фиксированной точкой в двоичном представлении.
  */
 class FixedPoint {
+    friend class FixedPointDivisor;
+    template <size_t IntLimbs, size_t FracLimbs> friend class StaticFixedPoint;
+
+    friend FixedPoint fma(const FixedPoint &a, const FixedPoint &b, const FixedPoint &c);
+    friend FixedPoint fmma(const FixedPoint &a, const FixedPoint &b, const FixedPoint &c, const FixedPoint &d);
+    friend FixedPoint fmms(const FixedPoint &a, const FixedPoint &b, const FixedPoint &c, const FixedPoint &d);
+    friend FixedPoint sum_of(std::initializer_list<std::reference_wrapper<const FixedPoint>> terms);
+
+    friend std::from_chars_result from_chars(const char *first, const char *last, FixedPoint &value, int frac_bits);
+    friend std::to_chars_result to_chars(char *first, char *last, const FixedPoint &value, int digits);
+    friend size_t to_chars_size(const FixedPoint &value, int digits);
+
 public:
     /**
      * @brief Конструктор из строки
@@ -45,21 +65,79 @@ public:
      */
     FixedPoint(const double &num, int frac_bits = 32);
 
+    /**
+     * @brief Конструктор из long double
+     * @param num Число для инициализации, раскладывается так же точно, как double
+     * @param frac_bits Количество бит дробной части (по умолчанию 32)
+     */
+    FixedPoint(long double num, int frac_bits = 32);
+
+    /**
+     * @brief Конструктор из целого числа
+     * @param value Значение, записывается в лимбы напрямую, без строки
+     * @param frac_bits Количество бит дробной части (по умолчанию 32)
+     */
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t)>>
+    FixedPoint(T value, int frac_bits = 32) : fractional_bits(frac_bits) {
+        uint64_t abs_value = scalar_abs(value);
+        uint32_t mag[2] = {static_cast<uint32_t>(abs_value), static_cast<uint32_t>(abs_value >> 32)};
+        assign_scaled(mag, 2, 0, frac_bits);
+        is_negative = scalar_negative(value);
+    }
+
+#ifdef __SIZEOF_INT128__
+    /**
+     * @brief Конструктор из 128-битного целого
+     * @param value Значение
+     * @param frac_bits Количество бит дробной части (по умолчанию 32)
+     */
+    FixedPoint(__int128 value, int frac_bits = 32);
+
+    /**
+     * @brief Конструктор из беззнакового 128-битного целого
+     * @param value Значение
+     * @param frac_bits Количество бит дробной части (по умолчанию 32)
+     */
+    FixedPoint(unsigned __int128 value, int frac_bits = 32);
+#endif
+
+    /**
+     * @brief Ближайшее к числу значение double
+     * @return Число, округлённое к ближайшему (при равенстве - к чётному);
+     * слишком большие по модулю числа дают бесконечность
+     * @details Читаются только три старших лимба, остальные учитываются
+     * одним битом «есть ли ненулевые биты ниже», поэтому время не зависит
+     * от точности числа.
+     */
+    double to_double() const;
+
     /// @name Битвые операции
     
     /**
      * @brief Оператор битового сдвига влево
-     * @param n Количество бит для сдвига
-     * @return Число со сдвинутыми битами
+     * @param n Количество бит для сдвига, отрицательное - сдвиг вправо
+     * @return Число, умноженное на 2^n
      */
     FixedPoint operator<<(int n) const;
     
     /**
      * @brief Оператор битового сдвига вправо
-     * @param n Количество бит для сдвига
-     * @return Число со сдвинутыми битами
+     * @param n Количество бит для сдвига, отрицательное - сдвиг влево
+     * @return Число, делённое на 2^n без потери бит
      */
     FixedPoint operator>>(int n) const;
+
+    /**
+     * @brief Умножает число на 2^exp на месте, как ldexp
+     * @param exp Показатель степени двойки, может быть отрицательным
+     * @return *this
+     * @details Сдвиг точен: дробная часть удлиняется, если младшие биты
+     * уходят за точку. Лимбы сдвигаются на exp mod 32 бит одним проходом,
+     * а целая часть exp / 32 лимбов - переносом точки, после чего число
+     * нормализуется. Ненулевой сдвиг даёт то же, что умножение или
+     * деление на FixedPoint("2.0") |exp| раз.
+     */
+    FixedPoint &scale_by_pow2(long long exp);
     
     /**
      * @brief Оператор побитового XOR
@@ -88,6 +166,19 @@ public:
      */
     FixedPoint& operator=(const FixedPoint& other);
 
+    /**
+     * @brief Конструктор перемещения
+     * @param other Число, лимбы которого забираются без копирования
+     */
+    FixedPoint(FixedPoint&& other) noexcept;
+
+    /**
+     * @brief Оператор перемещающего присваивания
+     * @param other Число, лимбы которого забираются без копирования
+     * @return Ссылка на текущий объект
+     */
+    FixedPoint& operator=(FixedPoint&& other) noexcept;
+
     /// @name Арифметические операторы
     /// @{
     
@@ -95,29 +186,56 @@ public:
      * @brief Оператор сложения
      * @param other Слагаемое
      * @return Сумма чисел
-     */
-    FixedPoint operator+(const FixedPoint &other) const;
+     *
+     * @details Перегрузки для временных операндов (rvalue) складывают на
+     * месте в лимбах временного, поэтому цепочка a + b + c выделяет память
+     * только для первой суммы.
+     */
+    FixedPoint operator+(const FixedPoint &other) const &;
+    FixedPoint operator+(const FixedPoint &other) &&;
+    FixedPoint operator+(FixedPoint &&other) const &;
+    FixedPoint operator+(FixedPoint &&other) &&;
     
     /**
      * @brief Оператор вычитания
      * @param other Вычитаемое
      * @return Разность чисел
+     * @details Перегрузки для временных операндов вычитают на месте
      */
-    FixedPoint operator-(const FixedPoint &other) const;
+    FixedPoint operator-(const FixedPoint &other) const &;
+    FixedPoint operator-(const FixedPoint &other) &&;
+    FixedPoint operator-(FixedPoint &&other) const &;
+    FixedPoint operator-(FixedPoint &&other) &&;
     
     /**
      * @brief Оператор умножения
      * @param other Множитель
      * @return Произведение чисел
+     * @details Перегрузки для временных операндов записывают произведение в
+     * лимбы временного
      */
-    FixedPoint operator*(const FixedPoint &other) const;
+    FixedPoint operator*(const FixedPoint &other) const &;
+    FixedPoint operator*(const FixedPoint &other) &&;
+    FixedPoint operator*(FixedPoint &&other) const &;
+    FixedPoint operator*(FixedPoint &&other) &&;
+
+    /**
+     * @brief Квадрат числа
+     * @return Значение (*this) * (*this)
+     *
+     * @details Результат совпадает с умножением числа на себя, но
+     * симметричные частичные произведения вычисляются один раз.
+     */
+    FixedPoint square() const;
     
     /**
      * @brief Оператор деления
      * @param other Делитель
      * @return Частное от деления
+     * @details Для временного делимого частное записывается в его лимбы
      */
-    FixedPoint operator/(const FixedPoint &other) const;
+    FixedPoint operator/(const FixedPoint &other) const &;
+    FixedPoint operator/(const FixedPoint &other) &&;
     
     /**
      * @brief Деление с остатком
@@ -125,12 +243,100 @@ public:
      * @return Пара: частное и остаток
      */
     std::pair<FixedPoint, FixedPoint> divide_with_remainder(const FixedPoint &other) const;
+
+    /**
+     * @brief Обратное число 1 / (*this)
+     * @param precision Количество бит дробной части результата
+     * @return Обратное число, усечённое до precision бит после точки
+     * @throw std::runtime_error если число равно нулю
+     *
+     * @details Вычисляется итерацией Ньютона с удвоением точности
+     * (limbs::invert), поэтому стоимость пропорциональна стоимости умножения.
+     */
+    FixedPoint reciprocal(size_t precision) const;
     
+    /// @}
+
+    /// @name Арифметика с машинными целыми
+    /// Принимают int64_t, uint64_t и остальные целые типы. Результат тот же,
+    /// что и с FixedPoint(value, 0), но операнд не превращается в длинное
+    /// число: значение прибавляется, умножается или делится за один проход
+    /// по лимбам.
+    /// @{
+
+    /**
+     * @brief Сложение с целым числом
+     * @param value Слагаемое
+     * @return Сумма чисел
+     */
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    FixedPoint operator+(T value) const & { return add_scalar(scalar_abs(value), scalar_negative(value)); }
+    /// Для временного числа: без этой перегрузки вызов неоднозначен с operator+(FixedPoint &&)
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    FixedPoint operator+(T value) && { return add_scalar(scalar_abs(value), scalar_negative(value)); }
+
+    /**
+     * @brief Вычитание целого числа
+     * @param value Вычитаемое
+     * @return Разность чисел
+     */
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    FixedPoint operator-(T value) const & { return add_scalar(scalar_abs(value), !scalar_negative(value)); }
+    /// Для временного числа: без этой перегрузки вызов неоднозначен с operator-(FixedPoint &&)
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    FixedPoint operator-(T value) && { return add_scalar(scalar_abs(value), !scalar_negative(value)); }
+
+    /**
+     * @brief Умножение на целое число
+     * @param value Множитель
+     * @return Произведение с той же дробной частью, что у *this
+     */
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    FixedPoint operator*(T value) const & { return mul_scalar(scalar_abs(value), scalar_negative(value)); }
+    /// Для временного числа: без этой перегрузки вызов неоднозначен с operator*(FixedPoint &&)
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    FixedPoint operator*(T value) && { return mul_scalar(scalar_abs(value), scalar_negative(value)); }
+
+    /**
+     * @brief Деление на целое число
+     * @param value Делитель
+     * @return Частное с той же дробной частью, что у *this
+     * @throw std::runtime_error при делении на ноль
+     */
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    FixedPoint operator/(T value) const & { return div_scalar(scalar_abs(value), scalar_negative(value)); }
+    /// Для временного числа: без этой перегрузки вызов неоднозначен с operator/(FixedPoint &&)
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    FixedPoint operator/(T value) && { return div_scalar(scalar_abs(value), scalar_negative(value)); }
+
+    /**
+     * @brief Деление на целое число с остатком
+     * @param value Делитель
+     * @return Пара: целое частное и остаток со знаком делимого
+     * @throw std::runtime_error при делении на ноль
+     */
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    std::pair<FixedPoint, FixedPoint> divide_with_remainder(T value) const {
+        return divmod_scalar(scalar_abs(value), scalar_negative(value));
+    }
+
     /// @}
     
     /// @name Операторы сравнения
     /// @{
     
+    /**
+     * @brief Трёхзначное сравнение
+     * @param other Число для сравнения
+     * @return Отрицательное, ноль или положительное, если *this меньше,
+     * равно или больше other
+     * @details Сравнивает знаки и положение старшего значащего лимба за O(1),
+     * лимбы просматриваются только при совпадении порядков - одним проходом
+     * сверху. Нули с разными знаками равны. На compare построены все
+     * операторы сравнения.
+     */
+    int compare(const FixedPoint &other) const;
+
     bool operator>(const FixedPoint &other) const;
     bool operator<(const FixedPoint &other) const;
     bool operator==(const FixedPoint &other) const;
@@ -163,108 +369,220 @@ public:
 
     /**
      * @brief Преобразует число в строку
-     * @param len Желаемая длина строки (-1 для автоматической)
+     * @param len Количество цифр после точки (-1 для автоматического)
      * @return Строковое представление числа
+     * @details Дробь длиннее len округляется половиной вверх
      */
     std::string to_string(int len = -1) const;
 
+    /// Приёмник текста для write_digits: получает очередной блок (указатель и длину)
+    using DigitSink = std::function<void(const char *, size_t)>;
+
+    /**
+     * @brief Записывает число в поток, не собирая строку целиком
+     * @param out Поток
+     * @param digits Количество цифр после точки (-1 для автоматического)
+     * @param round true - округлить, как to_string(digits); false - усечь
+     * @details При round = true выводится то же, что to_string(digits)
+     */
+    void write_digits(std::ostream &out, int digits = -1, bool round = true) const;
+
+    /**
+     * @brief Отдаёт десятичную запись числа блоками по мере перевода
+     * @param sink Получает знак, цифры целой части, точку и цифры дроби
+     * блоками не длиннее limbs::DIGIT_BLOCK_SIZE
+     * @param digits Количество цифр после точки (-1 для автоматического)
+     * @param round true - округлить, как to_string(digits); false - усечь
+     * @details Сверх двоичного числа нужна память на один блок и на
+     * промежуточные частные перевода, а не на всю строку.
+     */
+    void write_digits(const DigitSink &sink, int digits = -1, bool round = true) const;
+
 private:
-    std::vector<uint32_t> integer;    ///< Двоичное представление целой части
-    std::vector<uint32_t> fractional; ///< Двоичное представление дробной части
+    /// Лимбы числа, младший первым: сначала дробная часть, затем целая.
+    /// Число занимает окно [offset, offset + length), лимбы вне окна - запас,
+    /// поэтому отбрасывание нулевых лимбов и рост не сдвигают данные.
+    LimbBuffer limb_buffer;
+    size_t offset = 0;                ///< Индекс младшего лимба числа в limb_buffer
+    size_t frac_limbs = 0;            ///< Количество лимбов дробной части
+    size_t length = 0;                ///< Количество лимбов дробной и целой частей
+    size_t top = 0;                   ///< Лимбы окна до старшего ненулевого включительно, 0 у нуля
     uint32_t fractional_bits;         ///< Количество бит дробной части
     bool is_negative = false;         ///< Флаг отрицательного числа
 
+    /// @name Доступ к лимбам числа
+    /// @{
+    uint32_t *limb_data() { return limb_buffer.data() + offset; }             ///< Младший лимб дробной части
+    const uint32_t *limb_data() const { return limb_buffer.data() + offset; } ///< Младший лимб дробной части
+    uint32_t *int_data() { return limb_data() + frac_limbs; }                 ///< Младший лимб целой части
+    const uint32_t *int_data() const { return limb_data() + frac_limbs; }     ///< Младший лимб целой части
+    size_t int_size() const { return length - frac_limbs; }                   ///< Количество лимбов целой части
+    /// @}
+
     /**
-     * @brief Проверяет, является ли число нулём
-     * @return true если число равно нулю
+     * @brief Пустое число для результата операции
+     * @details Лимбы затем записываются через assign_limbs. В отличие от
+     * FixedPoint("0.0", 0) строка не разбирается и куча не используется.
      */
-    bool is_zero() const;
+    FixedPoint() : fractional_bits(0) {}
 
     /**
-     * @brief Вспомогательная функция для определения поведения операций
+     * @brief Модуль целого числа в виде uint64_t
+     */
+    template <typename T>
+    static uint64_t scalar_abs(T value) {
+        static_assert(sizeof(T) <= sizeof(uint64_t), "integer operand wider than 64 bits");
+        if constexpr (std::is_signed_v<T>) {
+            return value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+        } else {
+            return static_cast<uint64_t>(value);
+        }
+    }
+
+    /**
+     * @brief Знак целого числа
      */
-    Op_behavior helper(const FixedPoint &a, const FixedPoint &b, char op) const;
+    template <typename T>
+    static bool scalar_negative(T value) {
+        if constexpr (std::is_signed_v<T>) {
+            return value < 0;
+        } else {
+            return false;
+        }
+    }
+
+    /// @name Реализация арифметики с машинными целыми (value - модуль, negative - знак)
+    /// @{
+    FixedPoint add_scalar(uint64_t value, bool negative) const;
+    FixedPoint mul_scalar(uint64_t value, bool negative) const;
+    FixedPoint div_scalar(uint64_t value, bool negative) const;
+    std::pair<FixedPoint, FixedPoint> divmod_scalar(uint64_t value, bool negative) const;
+    /// @}
 
     /**
-     * @brief Сравнивает модули чисел
-     * @return true если |a| > |b|
+     * @brief Копия лимбов числа
+     * @param extra Количество нулевых лимбов, добавляемых сверху
+     * @return Лимбы дробной и целой частей, младший первым
      */
-    bool bigger_abs(const FixedPoint &a, const FixedPoint &b) const;
+    LimbBuffer joined_limbs(size_t extra = 0) const;
 
     /**
-     * @brief Сравнивает модули чисел
-     * @return true если |a| < |b|
+     * @brief Забирает лимбы результата и нормализует число
+     * @param data Лимбы дробной и целой частей, младший первым
+     * @param frac_sz Сколько младших лимбов относится к дробной части
+     *
+     * @details Отбрасывает младшие нулевые лимбы дробной части и старшие
+     * нулевые лимбы целой (оставляя хотя бы по одному) и выставляет
+     * fractional_bits по числу оставшихся дробных лимбов. Знак не меняется.
      */
-    bool less_abs(const FixedPoint &a, const FixedPoint &b) const;
+    void assign_limbs(LimbBuffer &&data, size_t frac_sz);
 
     /**
-     * @brief Выводит битовое представление 32-битного числа
+     * @brief Записывает целую и дробную части без нормализации
      */
-    void printBits(uint32_t value) const;
+    void assign_parts(const std::vector<uint32_t> &int_part, const std::vector<uint32_t> &frac_part);
 
     /**
-     * @brief Складывает дробные части чисел
-     * @return Пара: результат и флаг переноса
+     * @brief Целая часть и цифры дроби для десятичного вывода
      */
-    std::pair<std::vector<uint32_t>, bool> add_frac(const std::vector<uint32_t> &a,
-                                                  const std::vector<uint32_t> &b,
-                                                  uint32_t carry = 0) const;
+    struct DecimalParts {
+        LimbBuffer integer;  ///< Целая часть с учётом переноса от округления
+        LimbBuffer fraction; ///< Первые frac_digits цифр дроби как целое число
+        size_t frac_digits;  ///< Количество цифр дроби, 0 - дробь выводится как "0"
+    };
 
     /**
-     * @brief Складывает целые части чисел
-     * @return Пара: результат и флаг переноса
+     * @brief Готовит десятичный вывод с digits цифрами после точки
+     * @details Дробь выводится не длиннее 8 цифр на каждый лимб до младшего
+     * ненулевого. Если она кончается раньше, выводятся все её цифры без
+     * нулей в конце, иначе - ровно digits (или предел) цифр, усечённых или
+     * округлённых половиной вверх с переносом в целую часть.
      */
-    std::pair<std::vector<uint32_t>, bool> add_int(const std::vector<uint32_t> &a,
-                                                 const std::vector<uint32_t> &b,
-                                                 uint32_t carry = 0) const;
+    DecimalParts decimal_parts(int digits, bool round) const;
 
     /**
-     * @brief Вычитает два числа
-     * @return Пара: целая и дробная части результата
+     * @brief Записывает модуль mag * 2^exp без нормализации
+     * @param mag Лимбы модуля, младший первым
+     * @param n Количество лимбов mag
+     * @param exp Показатель степени двойки
+     * @param frac_bits Количество бит дробной части
+     *
+     * @details Раскладка та же, что у разбора строки: ceil(frac_bits / 32)
+     * дробных лимбов, биты за frac_bits отбрасываются (усечение к нулю),
+     * целая часть - без старших нулевых лимбов, но не короче одного.
+     * Знак не меняется.
+     */
+    void assign_scaled(const uint32_t *mag, size_t n, long long exp, int frac_bits);
+
+    /**
+     * @brief Добавляет count нулевых лимбов снизу дробной части
      */
-    std::pair<std::vector<uint32_t>, std::vector<uint32_t>>
-    subtract_nums(const FixedPoint &a, const FixedPoint &b) const;
+    void extend_fraction(size_t count);
 
     /**
-     * @brief Вычитает два 32-битных числа с учётом заёма
-     * @return Флаг заёма
+     * @brief Добавляет count нулевых лимбов сверху целой части
      */
-    int subtract(uint32_t &res, uint32_t val_a, uint32_t val_b, uint32_t borrow = 0) const;
+    void extend_integer(size_t count);
 
     /**
-     * @brief Вычитает два вектора чисел
+     * @brief Проверяет, является ли число нулём
+     * @return true если число равно нулю
      */
-    std::vector<uint32_t> subtract_vec(const std::vector<uint32_t> &a, 
-                                     const std::vector<uint32_t> &b) const;
+    bool is_zero() const { return top == 0; }
 
     /**
-     * @brief Делит два числа
-     * @return Пара: целая и дробная части результата
+     * @brief Пересчитывает top после изменения лимбов
+     * @details Старший лимб окна обычно ненулевой, поэтому просмотр короткий
      */
-    std::pair<std::vector<uint32_t>, std::vector<uint32_t>>
-    divide(const FixedPoint &a, const FixedPoint &b) const;
+    void update_top();
+
+    /**
+     * @brief Вспомогательная функция для определения поведения операций
+     */
+    Op_behavior helper(const FixedPoint &a, const FixedPoint &b, char op) const;
 
     /**
-     * @brief Сравнивает два вектора чисел
-     * @return true если a >= b
+     * @brief Сравнивает модули чисел
+     * @return -1, 0 или 1, если |a| меньше, равен или больше |b|
      */
-    bool not_less_vec(const std::vector<uint32_t> &a, 
-                     const std::vector<uint32_t> &b) const;
+    static int compare_abs(const FixedPoint &a, const FixedPoint &b);
 
     /**
-     * @brief Добавляет бит при делении
+     * @brief Выводит битовое представление 32-битного числа
      */
-    void add_bit_div(std::vector<uint32_t> &vec, uint32_t bit_added, bool is_one) const;
+    void printBits(uint32_t value) const;
 
     /**
-     * @brief Преобразует целую часть из строки в двоичный вид
+     * @brief Прибавляет (op = '+') или вычитает (op = '-') число на месте
      */
-    std::vector<uint32_t> int_part_to_bin(const std::string& num_str) const;
+    void add_signed(const FixedPoint &other, char op);
 
     /**
-     * @brief Умножает десятичную строку на 2
+     * @brief Складывает (add_abs = true) или вычитает модуль other из модуля
+     * *this на месте, без нормализации
      */
-    std::string mult_by_two(const std::string &num_str) const;
+    void accumulate(const FixedPoint &other, bool add_abs);
+
+    /**
+     * @brief Точное произведение модулей без нормализации, знак - как у a * b
+     */
+    static FixedPoint raw_product(const FixedPoint &a, const FixedPoint &b);
+
+    /**
+     * @brief Убирает лишние нулевые лимбы и обновляет fractional_bits
+     */
+    void normalize();
+
+    /**
+     * @brief Делит модули двух чисел
+     * @return Лимбы частного, младшие a.frac_limbs + b.frac_limbs - дробная часть
+     */
+    LimbBuffer divide(const FixedPoint &a, const FixedPoint &b) const;
+
+    /**
+     * @brief Преобразует целую часть из строки в двоичный вид
+     */
+    std::vector<uint32_t> int_part_to_bin(const std::string& num_str) const;
 
     /**
      * @brief Преобразует дробную часть из строки в двоичный вид
@@ -286,4 +604,104 @@ private:
  */
 FixedPoint operator""_long(long double number);
 
+/// @name Совмещённые операции
+/// Вычисляют выражение целиком в лимбах результата: промежуточные суммы не
+/// создаются, а нормализация выполняется один раз в конце. Результат, включая
+/// знак нулевого результата, тот же, что у записи через операторы слева
+/// направо: сложение и умножение FixedPoint точны.
+/// @{
+
+/**
+ * @brief Умножение со сложением: a * b + c
+ */
+FixedPoint fma(const FixedPoint &a, const FixedPoint &b, const FixedPoint &c);
+
+/**
+ * @brief Сумма двух произведений: a * b + c * d
+ */
+FixedPoint fmma(const FixedPoint &a, const FixedPoint &b, const FixedPoint &c, const FixedPoint &d);
+
+/**
+ * @brief Разность двух произведений: a * b - c * d
+ */
+FixedPoint fmms(const FixedPoint &a, const FixedPoint &b, const FixedPoint &c, const FixedPoint &d);
+
+/**
+ * @brief Сумма нескольких чисел
+ * @param terms Слагаемые, хотя бы одно
+ * @throw std::invalid_argument если слагаемых нет
+ * @details Лимбы результата сразу расширяются до самых длинных дробной и
+ * целой частей слагаемых, после чего каждое слагаемое прибавляется на
+ * месте одним проходом.
+ */
+FixedPoint sum_of(std::initializer_list<std::reference_wrapper<const FixedPoint>> terms);
+
+/**
+ * @brief Сумма нескольких чисел: sum_of(a, b, c, d)
+ */
+template <typename... Rest>
+FixedPoint sum_of(const FixedPoint &first, const Rest &... rest) {
+    static_assert((std::is_same_v<Rest, FixedPoint> && ...), "sum_of expects FixedPoint terms");
+    return sum_of({std::cref(first), std::cref(rest)...});
+}
+
+/// @}
+
+/// @name Преобразования в стиле <charconv>
+/// Не создают строк и не бросают исключений. Для чисел до
+/// CHARS_SCRATCH_BYTES / 64 лимбов временные лимбы берутся из массива
+/// CHARS_SCRATCH_BYTES байт на стеке, и куча не используется; чего не
+/// хватило, а также память для более длинных чисел берутся из
+/// limb_resource(), так что её источник можно задать через
+/// LimbResourceScope. Степени 10^(9 * 2^k) для длинных чисел хранятся в
+/// кэше потока и вычисляются при первом обращении.
+///
+/// Размер массива задаётся при сборке макросом
+/// LONG_ARITHMETIC_CHARS_SCRATCH_BYTES (в CMake - одноимённая переменная
+/// кэша, по умолчанию 16384) и должен быть одинаковым для библиотеки и
+/// использующего её кода.
+/// @{
+
+#ifndef LONG_ARITHMETIC_CHARS_SCRATCH_BYTES
+#define LONG_ARITHMETIC_CHARS_SCRATCH_BYTES (16 * 1024)
+#endif
+
+/// Размер временной памяти на стеке для from_chars, to_chars и to_chars_size (байт)
+constexpr size_t CHARS_SCRATCH_BYTES = LONG_ARITHMETIC_CHARS_SCRATCH_BYTES;
+static_assert(CHARS_SCRATCH_BYTES > 0, "LONG_ARITHMETIC_CHARS_SCRATCH_BYTES must be positive");
+
+/**
+ * @brief Разбирает десятичное число из [first, last)
+ * @param value Результат; при ошибке не меняется
+ * @param frac_bits Количество бит дробной части
+ * @return ptr - первый неразобранный символ; ec = std::errc::invalid_argument,
+ * если в начале нет числа или frac_bits < 0 (тогда ptr = first)
+ * @details Формат - [+|-]цифры[.цифры], хотя бы одна цифра до или после
+ * точки. Значение то же, что у FixedPoint(std::string(first, ptr), frac_bits).
+ * Буфер value переиспользуется: память выделяется, только если в него не
+ * помещается результат.
+ */
+std::from_chars_result from_chars(const char *first, const char *last, FixedPoint &value, int frac_bits = 32);
+
+/**
+ * @brief Разбирает десятичное число из строки
+ */
+std::from_chars_result from_chars(std::string_view str, FixedPoint &value, int frac_bits = 32);
+
+/**
+ * @brief Записывает число в [first, last) без завершающего нуля
+ * @param digits Количество цифр после точки (-1 для автоматического)
+ * @return ptr - конец записи; если места не хватило - ptr = last и
+ * ec = std::errc::value_too_large, нужный размер - to_chars_size
+ * @details Записывает то же, что to_string(digits)
+ */
+std::to_chars_result to_chars(char *first, char *last, const FixedPoint &value, int digits = -1);
+
+/**
+ * @brief Точное количество символов, которое запишет to_chars(..., value, digits)
+ */
+size_t to_chars_size(const FixedPoint &value, int digits = -1);
+
+/// @}
+
 #endif // LONG_NUM_H
\ No newline at end of file
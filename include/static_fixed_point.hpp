@@ -0,0 +1,258 @@
+/**
+ * @file static_fixed_point.hpp
+ * @brief Число фиксированной точки с точностью, заданной при компиляции
+ */
+
+#ifndef STATIC_FIXED_POINT_H
+#define STATIC_FIXED_POINT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include "../include/long_arithmetic.hpp"
+#include "../include/limb_kernels.hpp"
+
+/**
+ * @class StaticFixedPoint
+ * @brief Число фиксированной точки из IntLimbs целых и FracLimbs дробных лимбов
+ *
+ * Лимбы хранятся в std::array внутри объекта (младший первым: сначала
+ * дробная часть, затем целая), число не обращается к куче и целиком
+ * помещается в структуры, которые должны оставаться в кэше. Длины известны
+ * при компиляции, поэтому циклы сложения, умножения и сравнения имеют
+ * постоянное число итераций и разворачиваются компилятором; все операции,
+ * кроме преобразований в FixedPoint и обратно, - constexpr.
+ *
+ * Представление то же, что у FixedPoint: модуль и знак. Результаты
+ * совпадают с FixedPoint, усечённым до FracLimbs дробных лимбов: произведение
+ * усекается к нулю, нулевой результат сложения получает знак левого операнда.
+ * Целая часть вычисляется по модулю 2^(32 * IntLimbs).
+ *
+ * @tparam IntLimbs Количество 32-битных лимбов целой части
+ * @tparam FracLimbs Количество 32-битных лимбов дробной части
+ */
+template <size_t IntLimbs, size_t FracLimbs>
+class StaticFixedPoint {
+    static_assert(IntLimbs >= 1, "StaticFixedPoint needs at least one integer limb");
+
+public:
+    /// Общее количество лимбов
+    static constexpr size_t LIMBS = IntLimbs + FracLimbs;
+    /// Количество бит дробной части
+    static constexpr size_t FRACTIONAL_BITS = 32 * FracLimbs;
+
+    /**
+     * @brief Ноль
+     */
+    constexpr StaticFixedPoint() : storage{}, is_negative(false) {}
+
+    /**
+     * @brief Конструктор из целого числа
+     * @param value Значение, не шире 64 бит
+     */
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    constexpr StaticFixedPoint(T value) : storage{}, is_negative(false) {
+        uint64_t abs_value = static_cast<uint64_t>(value);
+        if constexpr (std::is_signed_v<T>) {
+            is_negative = value < 0;
+            if (is_negative) abs_value = 0 - abs_value;
+        }
+        storage[FracLimbs] = static_cast<uint32_t>(abs_value);
+        if constexpr (IntLimbs > 1) {
+            storage[FracLimbs + 1] = static_cast<uint32_t>(abs_value >> 32);
+        }
+    }
+
+    /**
+     * @brief Конструктор из FixedPoint
+     * @param value Число, дробная часть которого усекается до FracLimbs лимбов
+     * @throw std::overflow_error если целая часть не помещается в IntLimbs лимбов
+     */
+    explicit StaticFixedPoint(const FixedPoint &value) : storage{}, is_negative(value.is_negative) {
+        const uint32_t *frac = value.limb_data();
+        for (size_t i = 0; i < FracLimbs && i < value.frac_limbs; ++i) {
+            storage[FracLimbs - 1 - i] = frac[value.frac_limbs - 1 - i];
+        }
+
+        const uint32_t *int_part = value.int_data();
+        size_t int_sz = limbs::normalized_size(int_part, value.int_size());
+        if (int_sz > IntLimbs) {
+            throw std::overflow_error("Integer part does not fit into StaticFixedPoint");
+        }
+        for (size_t i = 0; i < int_sz; ++i) {
+            storage[FracLimbs + i] = int_part[i];
+        }
+    }
+
+    /**
+     * @brief Преобразует в FixedPoint с FRACTIONAL_BITS битами дробной части
+     */
+    FixedPoint to_fixed_point() const {
+        FixedPoint result;
+        result.limb_buffer.assign(storage.data(), storage.data() + LIMBS);
+        if (FracLimbs == 0) {
+            // У FixedPoint всегда есть хотя бы один дробный лимб
+            result.limb_buffer.insert_zeros(1);
+        }
+        result.offset = 0;
+        result.frac_limbs = FracLimbs == 0 ? 1 : FracLimbs;
+        result.length = result.limb_buffer.size();
+        result.update_top();
+        result.fractional_bits = static_cast<uint32_t>(32 * result.frac_limbs);
+        result.is_negative = is_negative;
+        return result;
+    }
+
+    /**
+     * @brief Преобразует число в строку
+     * @param len Желаемая длина строки (-1 для автоматической)
+     */
+    std::string to_string(int len = -1) const { return to_fixed_point().to_string(len); }
+
+    /// @name Доступ к лимбам
+    /// @{
+    constexpr const std::array<uint32_t, LIMBS> &limb_array() const { return storage; } ///< Лимбы, младший первым
+    constexpr bool negative() const { return is_negative; }                          ///< Знак числа
+    /// @}
+
+    /**
+     * @brief Проверяет, является ли число нулём
+     */
+    constexpr bool is_zero() const {
+        for (size_t i = 0; i < LIMBS; ++i) {
+            if (storage[i] != 0) return false;
+        }
+        return true;
+    }
+
+    /// @name Арифметика
+    /// @{
+
+    constexpr StaticFixedPoint operator-() const {
+        StaticFixedPoint result = *this;
+        result.is_negative = !is_negative;
+        return result;
+    }
+
+    /**
+     * @brief Сложение на месте
+     * @details При разных знаках из большего модуля вычитается меньший;
+     * знак нулевого результата - как у *this
+     */
+    constexpr StaticFixedPoint &operator+=(const StaticFixedPoint &other) {
+        add_signed(other, other.is_negative);
+        return *this;
+    }
+
+    /**
+     * @brief Вычитание на месте
+     */
+    constexpr StaticFixedPoint &operator-=(const StaticFixedPoint &other) {
+        add_signed(other, !other.is_negative);
+        return *this;
+    }
+
+    /**
+     * @brief Умножение на месте
+     * @details Произведение считается столбиком целиком: внутренний цикл
+     * имеет постоянную длину LIMBS и разворачивается, а младшие FracLimbs
+     * и старшие IntLimbs лимбов отбрасываются.
+     */
+    constexpr StaticFixedPoint &operator*=(const StaticFixedPoint &other) {
+        std::array<uint32_t, 2 * LIMBS> product{};
+        for (size_t i = 0; i < LIMBS; ++i) {
+            // a[i] * b[j] + r + carry <= 2^64 - 1, аккумулятор не переполняется
+            uint64_t carry = 0;
+            uint64_t a_i = storage[i];
+            for (size_t j = 0; j < LIMBS; ++j) {
+                carry += a_i * other.storage[j] + product[i + j];
+                product[i + j] = static_cast<uint32_t>(carry);
+                carry >>= 32;
+            }
+            product[i + LIMBS] = static_cast<uint32_t>(carry);
+        }
+        for (size_t i = 0; i < LIMBS; ++i) {
+            storage[i] = product[FracLimbs + i];
+        }
+        is_negative = is_negative != other.is_negative;
+        return *this;
+    }
+
+    constexpr StaticFixedPoint operator+(const StaticFixedPoint &other) const { StaticFixedPoint r = *this; return r += other; }
+    constexpr StaticFixedPoint operator-(const StaticFixedPoint &other) const { StaticFixedPoint r = *this; return r -= other; }
+    constexpr StaticFixedPoint operator*(const StaticFixedPoint &other) const { StaticFixedPoint r = *this; return r *= other; }
+
+    /// @}
+
+    /// @name Сравнение
+    /// @{
+
+    /**
+     * @brief Трёхзначное сравнение
+     * @return -1, 0 или 1; нули разных знаков равны
+     */
+    constexpr int compare(const StaticFixedPoint &other) const {
+        bool this_zero = is_zero(), other_zero = other.is_zero();
+        if (this_zero && other_zero) return 0;
+        bool this_neg = is_negative && !this_zero, other_neg = other.is_negative && !other_zero;
+        if (this_neg != other_neg) return this_neg ? -1 : 1;
+        int abs_cmp = compare_abs(other);
+        return this_neg ? -abs_cmp : abs_cmp;
+    }
+
+    constexpr bool operator==(const StaticFixedPoint &other) const { return compare(other) == 0; }
+    constexpr bool operator!=(const StaticFixedPoint &other) const { return compare(other) != 0; }
+    constexpr bool operator<(const StaticFixedPoint &other) const { return compare(other) < 0; }
+    constexpr bool operator<=(const StaticFixedPoint &other) const { return compare(other) <= 0; }
+    constexpr bool operator>(const StaticFixedPoint &other) const { return compare(other) > 0; }
+    constexpr bool operator>=(const StaticFixedPoint &other) const { return compare(other) >= 0; }
+
+    /// @}
+
+private:
+    std::array<uint32_t, LIMBS> storage; ///< Лимбы дробной и целой частей, младший первым
+    bool is_negative;                    ///< Флаг отрицательного числа
+
+    /**
+     * @brief Сравнивает модули
+     * @return -1, 0 или 1
+     */
+    constexpr int compare_abs(const StaticFixedPoint &other) const {
+        for (size_t i = LIMBS; i-- > 0;) {
+            if (storage[i] != other.storage[i]) return storage[i] < other.storage[i] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Прибавляет модуль other со знаком other_negative
+     */
+    constexpr void add_signed(const StaticFixedPoint &other, bool other_negative) {
+        if (is_negative == other_negative) {
+            uint64_t carry = 0;
+            for (size_t i = 0; i < LIMBS; ++i) {
+                uint64_t cur = static_cast<uint64_t>(storage[i]) + other.storage[i] + carry;
+                storage[i] = static_cast<uint32_t>(cur);
+                carry = cur >> 32;
+            }
+            return;
+        }
+
+        // Из большего модуля вычитается меньший
+        bool swap = compare_abs(other) < 0;
+        const std::array<uint32_t, LIMBS> &big = swap ? other.storage : storage;
+        const std::array<uint32_t, LIMBS> &small = swap ? storage : other.storage;
+        uint32_t borrow = 0;
+        for (size_t i = 0; i < LIMBS; ++i) {
+            uint64_t cur = static_cast<uint64_t>(big[i]) - small[i] - borrow;
+            storage[i] = static_cast<uint32_t>(cur);
+            borrow = static_cast<uint32_t>(cur >> 63);
+        }
+        if (swap) is_negative = other_negative;
+    }
+};
+
+#endif // STATIC_FIXED_POINT_H
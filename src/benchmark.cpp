@@ -0,0 +1,519 @@
+/**
+ * @file benchmark.cpp
+ * @brief Замеры производительности ядер длинной арифметики
+ *
+ * Программа измеряет время умножения операндов длиной от 1 до 10 000 лимбов,
+ * сравнивает лимбовое ядро с прежним побитовым умножением и алгоритмы
+ * Карацубы и Тоома-Кука между собой для подбора порогов, а также
+ * масштабирование NTT-умножения на операндах до 10^7 лимбов, выигрыш
+ * от отдельного возведения в квадрат и от операций с машинными целыми,
+ * а также деление в сравнении с умножением той же длины, цену выделения
+ * памяти под промежуточные числа из кучи, пула потока и арены и выигрыш
+ * от точности, заданной при компиляции (StaticFixedPoint), и от
+ * совмещённых операций без промежуточных чисел, а также разбор и вывод
+ * длинных десятичных строк и строк средней длины через from_chars и to_chars.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <functional>
+#include <cmath>
+#include "../include/long_arithmetic.hpp"
+#include "../include/limb_kernels.hpp"
+#include "../include/limb_buffer.hpp"
+#include "../include/static_fixed_point.hpp"
+
+using limbs::limb_t;
+
+/**
+ * @brief Побитовое умножение, которым раньше пользовался FixedPoint::operator*
+ *
+ * Оставлено только как эталон для сравнения скорости.
+ */
+static void mul_bitwise_reference(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    size_t mid_mult_sz = (an + bn) * 32 + 1;
+    std::vector<uint32_t> mid_mult(mid_mult_sz);
+
+    for (size_t i = 0; i < an; i++)
+        for (size_t bit_a = 0; bit_a < 32; bit_a++)
+            for (size_t j = 0; j < bn; j++)
+                for (size_t bit_b = 0; bit_b < 32; bit_b++)
+                    mid_mult[32 * (i + j) + bit_a + bit_b] += (a[i] >> bit_a) & (b[j] >> bit_b) & 1;
+
+    std::fill(r, r + an + bn, 0);
+    for (size_t i = 0; i < mid_mult_sz - 1; i++) {
+        r[i / 32] |= (mid_mult[i] % 2) << (i % 32);
+        mid_mult[i + 1] += mid_mult[i] / 2;
+    }
+}
+
+/**
+ * @brief Измеряет среднее время одного вызова функции
+ * @param fn Измеряемая функция
+ * @return Время одного вызова в микросекундах
+ */
+static double time_us(const std::function<void()> &fn) {
+    using clock = std::chrono::high_resolution_clock;
+    size_t reps = 0;
+    auto start = clock::now();
+    double elapsed = 0;
+    do {
+        fn();
+        ++reps;
+        elapsed = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+    } while (elapsed < 200000.0 && reps < 1000000);
+    return elapsed / reps;
+}
+
+static std::vector<limb_t> random_limbs(std::mt19937 &rng, size_t n) {
+    std::vector<limb_t> v(n);
+    for (auto &x : v) x = rng();
+    return v;
+}
+
+/**
+ * @brief Сравнение умножения столбиком с побитовым эталоном
+ */
+static void bench_mul_basecase(std::mt19937 &rng) {
+    const size_t sizes[] = {1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1000, 2000, 5000, 10000};
+    const size_t reference_limit = 256;
+
+    std::cout << "mul_basecase (us per call)\n";
+    std::cout << std::setw(8) << "limbs" << std::setw(16) << "basecase"
+              << std::setw(16) << "bitwise" << std::setw(12) << "speedup" << "\n";
+
+    for (size_t n : sizes) {
+        auto a = random_limbs(rng, n), b = random_limbs(rng, n);
+        std::vector<limb_t> r(2 * n);
+
+        double t_fast = time_us([&] { limbs::mul_basecase(r.data(), a.data(), n, b.data(), n); });
+        std::cout << std::setw(8) << n << std::setw(16) << std::fixed << std::setprecision(3) << t_fast;
+
+        if (n <= reference_limit) {
+            double t_ref = time_us([&] { mul_bitwise_reference(r.data(), a.data(), n, b.data(), n); });
+            std::cout << std::setw(16) << t_ref << std::setw(11) << std::setprecision(1)
+                      << t_ref / t_fast << "x";
+        }
+        std::cout << "\n";
+    }
+}
+
+/**
+ * @brief Сравнение алгоритмов умножения для подбора порогов переключения
+ */
+static void bench_mul_tiers(std::mt19937 &rng) {
+    const size_t sizes[] = {16, 24, 32, 48, 64, 96, 128, 160, 200, 256, 320, 400, 512, 800, 1000, 2000, 5000, 10000};
+
+    std::cout << "\nmultiplication tiers (us per call)\n";
+    std::cout << std::setw(8) << "limbs" << std::setw(14) << "basecase" << std::setw(14) << "karatsuba"
+              << std::setw(14) << "toom3" << std::setw(14) << "toom4" << std::setw(14) << "mul" << "\n";
+
+    for (size_t n : sizes) {
+        auto a = random_limbs(rng, n), b = random_limbs(rng, n);
+        std::vector<limb_t> r(2 * n);
+        std::cout << std::setw(8) << n << std::fixed << std::setprecision(2);
+        std::cout << std::setw(14) << time_us([&] { limbs::mul_basecase(r.data(), a.data(), n, b.data(), n); });
+        std::cout << std::setw(14) << time_us([&] { limbs::mul_karatsuba(r.data(), a.data(), n, b.data(), n); });
+        std::cout << std::setw(14) << time_us([&] { limbs::mul_toom3(r.data(), a.data(), n, b.data(), n); });
+        std::cout << std::setw(14) << time_us([&] { limbs::mul_toom4(r.data(), a.data(), n, b.data(), n); });
+        std::cout << std::setw(14) << time_us([&] { limbs::mul(r.data(), a.data(), n, b.data(), n); });
+        std::cout << "\n";
+    }
+}
+
+/**
+ * @brief Сравнение возведения в квадрат с умножением различных чисел той же длины
+ */
+static void bench_sqr(std::mt19937 &rng) {
+    const size_t sizes[] = {8, 16, 32, 48, 64, 96, 128, 256, 1000, 4000, 10000, 100000};
+
+    std::cout << "\nsquaring vs multiplication (us per call)\n";
+    std::cout << std::setw(8) << "limbs" << std::setw(14) << "sqr_basecase" << std::setw(14) << "sqr_karatsuba"
+              << std::setw(14) << "sqr" << std::setw(14) << "mul" << std::setw(10) << "ratio" << "\n";
+
+    for (size_t n : sizes) {
+        auto a = random_limbs(rng, n), b = random_limbs(rng, n);
+        std::vector<limb_t> r(2 * n);
+        std::cout << std::setw(8) << n << std::fixed << std::setprecision(2);
+        if (n <= 256) {
+            std::cout << std::setw(14) << time_us([&] { limbs::sqr_basecase(r.data(), a.data(), n); })
+                      << std::setw(14) << time_us([&] { limbs::sqr_karatsuba(r.data(), a.data(), n); });
+        } else {
+            std::cout << std::setw(14) << "-" << std::setw(14) << "-";
+        }
+        double t_sqr = time_us([&] { limbs::sqr(r.data(), a.data(), n); });
+        double t_mul = time_us([&] { limbs::mul(r.data(), a.data(), n, b.data(), n); });
+        std::cout << std::setw(14) << t_sqr << std::setw(14) << t_mul << std::setw(10) << t_sqr / t_mul << "\n";
+    }
+}
+
+/**
+ * @brief Масштабирование NTT-умножения от 10^4 до 10^7 лимбов
+ * @param max_limbs Наибольшая длина операндов
+ *
+ * @details Последний столбец - время, делённое на n log2 n и приведённое к
+ * первой строке: при квазилинейной сложности он остаётся около единицы.
+ */
+static void bench_ntt(std::mt19937 &rng, size_t max_limbs) {
+    const size_t sizes[] = {10000, 30000, 100000, 300000, 1000000, 3000000, 10000000};
+
+    std::cout << "\nNTT multiplication (ms per call)\n";
+    std::cout << std::setw(10) << "limbs" << std::setw(14) << "ntt" << std::setw(14) << "toom4"
+              << std::setw(16) << "ntt/(n log n)" << "\n";
+
+    double base = 0;
+    for (size_t n : sizes) {
+        if (n > max_limbs) break;
+        auto a = random_limbs(rng, n), b = random_limbs(rng, n);
+        std::vector<limb_t> r(2 * n);
+
+        double t = time_us([&] { limbs::mul_ntt(r.data(), a.data(), n, b.data(), n); }) / 1000.0;
+        double norm = t / (n * std::log2(static_cast<double>(n)));
+        if (base == 0) base = norm;
+
+        std::cout << std::setw(10) << n << std::fixed << std::setprecision(2) << std::setw(14) << t;
+        if (n <= 100000) {
+            std::cout << std::setw(14) << time_us([&] { limbs::mul_toom4(r.data(), a.data(), n, b.data(), n); }) / 1000.0;
+        } else {
+            std::cout << std::setw(14) << "-";
+        }
+        std::cout << std::setw(16) << norm / base << "\n";
+    }
+}
+
+/**
+ * @brief Время деления 2n лимбов на n лимбов
+ */
+static void bench_div(std::mt19937 &rng) {
+    const size_t sizes[] = {2, 4, 8, 16, 32, 64, 128, 200, 256, 300, 400, 512, 700, 1000, 2000, 5000, 10000, 20000, 40000, 100000};
+
+    std::cout << "\ndivision 2n / n limbs (us per call)\n";
+    std::cout << std::setw(8) << "limbs" << std::setw(14) << "basecase" << std::setw(14) << "bz"
+              << std::setw(14) << "newton" << std::setw(14) << "invert" << std::setw(14) << "divrem" << std::setw(14) << "mul n x n" << "\n";
+
+    for (size_t n : sizes) {
+        auto a = random_limbs(rng, 2 * n), d = random_limbs(rng, n);
+        d.back() |= 0x80000000;
+        a.back() &= 0x7FFFFFFF;
+        std::vector<limb_t> q(n + 1), r(2 * n), u(2 * n);
+        std::cout << std::setw(8) << n << std::fixed << std::setprecision(2);
+        if (n >= 2 && n <= 5000) {
+            std::cout << std::setw(14) << time_us([&] {
+                std::copy(a.begin(), a.end(), u.begin());
+                limbs::div_basecase(q.data(), u.data(), 2 * n, d.data(), n);
+            });
+        } else {
+            std::cout << std::setw(14) << "-";
+        }
+        if (n >= 4) {
+            std::cout << std::setw(14) << time_us([&] {
+                std::copy(a.begin(), a.end(), u.begin());
+                limbs::div_dc(q.data(), u.data(), 2 * n, d.data(), n);
+            });
+        } else {
+            std::cout << std::setw(14) << "-";
+        }
+        if (n >= 2) {
+            std::cout << std::setw(14) << time_us([&] {
+                std::copy(a.begin(), a.end(), u.begin());
+                limbs::div_newton(q.data(), u.data(), 2 * n, d.data(), n);
+            });
+        } else {
+            std::cout << std::setw(14) << "-";
+        }
+        std::cout << std::setw(14) << time_us([&] { limbs::invert(q.data(), d.data(), n); });
+        std::cout << std::setw(14) << time_us([&] { limbs::divrem(q.data(), r.data(), a.data(), 2 * n, d.data(), n); });
+        std::cout << std::setw(14) << time_us([&] { limbs::mul(r.data(), a.data(), n, d.data(), n); }) << "\n";
+    }
+}
+
+/**
+ * @brief Деление на заранее подготовленный делитель против столбика
+ *
+ * @details Делимое вдвое длиннее делителя; обратное вычислено заранее,
+ * как в FixedPointDivisor.
+ */
+static void bench_preinv(std::mt19937 &rng) {
+    const size_t sizes[] = {2, 4, 8, 16, 32, 64, 128, 256, 512, 1000, 2000, 5000, 20000};
+
+    std::cout << "\nprecomputed inverse 2n / n limbs (us per call)\n";
+    std::cout << std::setw(8) << "limbs" << std::setw(14) << "basecase" << std::setw(14) << "bz"
+              << std::setw(14) << "preinv" << "\n";
+
+    for (size_t n : sizes) {
+        auto a = random_limbs(rng, 2 * n), d = random_limbs(rng, n);
+        d.back() |= 0x80000000;
+        a.back() &= 0x7FFFFFFF;
+        std::vector<limb_t> q(n + 1), u(2 * n), x(n + 1);
+        limbs::invert(x.data(), d.data(), n);
+        std::cout << std::setw(8) << n << std::fixed << std::setprecision(2);
+        if (n <= 5000) {
+            std::cout << std::setw(14) << time_us([&] {
+                std::copy(a.begin(), a.end(), u.begin());
+                limbs::div_basecase(q.data(), u.data(), 2 * n, d.data(), n);
+            });
+        } else {
+            std::cout << std::setw(14) << "-";
+        }
+        if (n >= 4) {
+            std::cout << std::setw(14) << time_us([&] {
+                std::copy(a.begin(), a.end(), u.begin());
+                limbs::div_dc(q.data(), u.data(), 2 * n, d.data(), n);
+            });
+        } else {
+            std::cout << std::setw(14) << "-";
+        }
+        std::cout << std::setw(14) << time_us([&] {
+            std::copy(a.begin(), a.end(), u.begin());
+            limbs::div_preinv(q.data(), u.data(), 2 * n, d.data(), n, x.data());
+        }) << "\n";
+    }
+
+    std::cout << "\none-limb division of n limbs (us per call)\n";
+    std::cout << std::setw(8) << "limbs" << std::setw(14) << "hardware" << std::setw(14) << "preinv" << "\n";
+    for (size_t n : {16, 256, 4096}) {
+        auto a = random_limbs(rng, n);
+        std::vector<limb_t> q(n);
+        // Делитель из генератора, чтобы компилятор не заменил деление умножением
+        const limb_t d = static_cast<limb_t>(rng() | 1);
+        const unsigned shift = __builtin_clz(d);
+        const limb_t dinv = limbs::invert_limb(d << shift);
+        std::cout << std::setw(8) << n << std::fixed << std::setprecision(3);
+        std::cout << std::setw(14) << time_us([&] {
+            limbs::dlimb_t rem = 0;
+            for (size_t i = n; i-- > 0;) {
+                limbs::dlimb_t cur = (rem << 32) | a[i];
+                q[i] = static_cast<limb_t>(cur / d);
+                rem = cur % d;
+            }
+        });
+        std::cout << std::setw(14) << time_us([&] {
+            limbs::divmod_1_preinv(q.data(), a.data(), n, d << shift, dinv, shift);
+        }) << "\n";
+    }
+}
+
+/**
+ * @brief Время FixedPoint::operator* на числах с заданной длиной дробной части
+ */
+static void bench_fixed_point_mul() {
+    std::cout << "\nFixedPoint::operator* (us per call)\n";
+    for (int frac_bits : {64, 256, 1024, 4096}) {
+        FixedPoint a("3.14159265358979323846", frac_bits);
+        FixedPoint b("2.71828182845904523536", frac_bits);
+        double t = time_us([&] { FixedPoint c = a * b; (void) c; });
+        std::cout << std::setw(8) << frac_bits << " bits" << std::setw(14)
+                  << std::setprecision(3) << t << "\n";
+    }
+}
+
+/**
+ * @brief Операции с машинным целым против операций с временным FixedPoint
+ */
+static void bench_scalar_ops() {
+    std::cout << "\nFixedPoint op integer vs op FixedPoint (us per call)\n";
+    std::cout << std::setw(13) << "frac bits" << std::setw(12) << "* 16" << std::setw(12) << "* FP(16)"
+              << std::setw(12) << "/ 1000003" << std::setw(12) << "/ FP(..)" << "\n";
+    for (int frac_bits : {256, 1024, 4096}) {
+        FixedPoint a("3.14159265358979323846", frac_bits);
+        std::cout << std::setw(8) << frac_bits << " bits" << std::fixed << std::setprecision(3);
+        std::cout << std::setw(12) << time_us([&] { FixedPoint c = a * 16; (void) c; });
+        std::cout << std::setw(12) << time_us([&] { FixedPoint c = a * FixedPoint(16.0, 256); (void) c; });
+        std::cout << std::setw(12) << time_us([&] { FixedPoint c = a / 1000003; (void) c; });
+        std::cout << std::setw(12) << time_us([&] { FixedPoint c = a / FixedPoint(1000003.0, 0); (void) c; });
+        std::cout << "\n";
+    }
+}
+
+/**
+ * @brief Выражение с промежуточными числами при разных источниках памяти для лимбов
+ */
+static void bench_limb_resources() {
+    std::cout << "\na * b - a / 3 + b (us per call)\n";
+    std::cout << std::setw(13) << "frac bits" << std::setw(12) << "heap" << std::setw(12) << "pool"
+              << std::setw(12) << "arena" << "\n";
+    for (int frac_bits : {256, 1024, 4096}) {
+        FixedPoint a("3.14159265358979323846", frac_bits);
+        FixedPoint b("2.71828182845904523536", frac_bits);
+        auto expr = [&] { FixedPoint c = a * b - a / 3 + b; (void) c; };
+        std::cout << std::setw(8) << frac_bits << " bits" << std::fixed << std::setprecision(3);
+        std::cout << std::setw(12) << time_us(expr);
+        {
+            LimbResourceScope scope(limb_pool());
+            std::cout << std::setw(12) << time_us(expr);
+        }
+        {
+            // Арена не освобождает память по отдельности, поэтому пересоздаётся на каждый вызов
+            std::cout << std::setw(12) << time_us([&] {
+                LimbArena arena;
+                LimbResourceScope scope(&arena);
+                expr();
+            });
+        }
+        std::cout << "\n";
+    }
+}
+
+/**
+ * @brief StaticFixedPoint против FixedPoint той же точности на a * b + c и a - b
+ */
+template <size_t FracLimbs>
+static void bench_static_row(const char *pi_str, const char *e_str) {
+    using Static = StaticFixedPoint<2, FracLimbs>;
+    FixedPoint a(pi_str, 32 * FracLimbs), b(e_str, 32 * FracLimbs), c = a - b;
+    Static sa(a), sb(b), sc(c);
+    std::cout << std::setw(8) << 32 * FracLimbs << " bits" << std::fixed << std::setprecision(4);
+    std::cout << std::setw(14) << time_us([&] { FixedPoint r = a * b + c; (void) r; });
+    std::cout << std::setw(14) << time_us([&] { Static r = sa * sb + sc; asm volatile("" : : "r"(&r) : "memory"); });
+    std::cout << std::setw(14) << time_us([&] { FixedPoint r = a - b; (void) r; });
+    std::cout << std::setw(14) << time_us([&] { Static r = sa - sb; asm volatile("" : : "r"(&r) : "memory"); });
+    std::cout << "\n";
+}
+
+static void bench_static_fixed_point() {
+    std::cout << "\nStaticFixedPoint<2, F> vs FixedPoint (us per call)\n";
+    std::cout << std::setw(13) << "frac bits" << std::setw(14) << "a*b+c dyn" << std::setw(14) << "a*b+c static"
+              << std::setw(14) << "a-b dyn" << std::setw(14) << "a-b static" << "\n";
+    const char *pi_str = "3.14159265358979323846264338327950288419716939937510";
+    const char *e_str = "2.71828182845904523536028747135266249775724709369995";
+    bench_static_row<2>(pi_str, e_str);
+    bench_static_row<8>(pi_str, e_str);
+    bench_static_row<16>(pi_str, e_str);
+}
+
+/**
+ * @brief Совмещённые операции против той же записи через операторы
+ */
+static void bench_fused_ops() {
+    std::cout << "\nfused vs operators (us per call)\n";
+    std::cout << std::setw(13) << "frac bits" << std::setw(12) << "a*b+c" << std::setw(12) << "fma"
+              << std::setw(12) << "a*b-c*d" << std::setw(12) << "fmms" << std::setw(12) << "a+b+c+d"
+              << std::setw(12) << "sum_of" << "\n";
+    for (int frac_bits : {256, 1024, 4096}) {
+        FixedPoint a("3.14159265358979323846", frac_bits), b("-2.71828182845904523536", frac_bits);
+        FixedPoint c("1.41421356237309504880", frac_bits), d("0.57721566490153286060", frac_bits);
+        std::cout << std::setw(8) << frac_bits << " bits" << std::fixed << std::setprecision(3);
+        std::cout << std::setw(12) << time_us([&] { FixedPoint r = a * b + c; (void) r; });
+        std::cout << std::setw(12) << time_us([&] { FixedPoint r = fma(a, b, c); (void) r; });
+        std::cout << std::setw(12) << time_us([&] { FixedPoint r = a * b - c * d; (void) r; });
+        std::cout << std::setw(12) << time_us([&] { FixedPoint r = fmms(a, b, c, d); (void) r; });
+        std::cout << std::setw(12) << time_us([&] { FixedPoint r = a + b + c + d; (void) r; });
+        std::cout << std::setw(12) << time_us([&] { FixedPoint r = sum_of(a, b, c, d); (void) r; });
+        std::cout << "\n";
+    }
+}
+
+/**
+ * @brief Разбор целой десятичной строки в FixedPoint и в лимбы (limbs::set_str)
+ * и дроби из стольких же цифр с точностью 256 бит
+ */
+static void bench_parse(std::mt19937 &rng) {
+    std::cout << "\ndecimal integer parsing (ms per call)\n";
+    std::cout << std::setw(10) << "digits" << std::setw(14) << "set_str" << std::setw(14) << "FixedPoint"
+              << std::setw(14) << "sqr same len" << std::setw(14) << "0.digits@256" << "\n";
+    for (size_t n : {1000, 10000, 100000, 1000000}) {
+        std::string digits(n, '0');
+        for (char &c : digits) c = static_cast<char>('1' + rng() % 9);
+        std::vector<limb_t> r(limbs::set_str_limbs(n));
+        size_t rn = limbs::set_str(r.data(), digits.data(), n);
+        std::vector<limb_t> sq(2 * rn);
+        std::cout << std::setw(10) << n << std::fixed << std::setprecision(3);
+        std::cout << std::setw(14) << time_us([&] { limbs::set_str(r.data(), digits.data(), n); }) / 1000;
+        std::cout << std::setw(14) << time_us([&] { FixedPoint x(digits, 0); (void) x; }) / 1000;
+        std::cout << std::setw(14) << time_us([&] { limbs::sqr(sq.data(), r.data(), rn); }) / 1000;
+        std::string fraction = "0." + digits;
+        std::cout << std::setw(14) << time_us([&] { FixedPoint x(fraction, 256); (void) x; }) / 1000;
+        std::cout << "\n";
+    }
+}
+
+/**
+ * @brief Вывод числа с заданным количеством цифр: to_string() целиком и to_string(100)
+ */
+static void bench_print(std::mt19937 &rng) {
+    std::cout << "\ndecimal output (ms per call)\n";
+    std::cout << std::setw(10) << "digits" << std::setw(14) << "to_string()" << std::setw(16) << "to_string(100)"
+              << std::setw(14) << "integer" << std::setw(16) << "write_digits" << "\n";
+    for (size_t n : {1000, 10000, 100000, 1000000}) {
+        std::string digits(n, '0');
+        for (char &c : digits) c = static_cast<char>('1' + rng() % 9);
+        // 8 цифр на 32 бита дроби: n цифр выводятся из 4n бит
+        FixedPoint x("3." + digits, static_cast<int>(4 * n));
+        FixedPoint y(digits, 0);
+        std::cout << std::setw(10) << n << std::fixed << std::setprecision(3);
+        std::cout << std::setw(14) << time_us([&] { std::string s = x.to_string(); (void) s; }) / 1000;
+        std::cout << std::setw(16) << time_us([&] { std::string s = x.to_string(100); (void) s; }) / 1000;
+        std::cout << std::setw(14) << time_us([&] { std::string s = y.to_string(); (void) s; }) / 1000;
+        size_t written = 0;
+        std::cout << std::setw(16) << time_us([&] {
+            x.write_digits([&](const char *, size_t k) { written += k; });
+        }) / 1000;
+        std::cout << "\n";
+    }
+}
+
+/**
+ * @brief Разбор и вывод чисел средней длины: строки и конструктор против from_chars и to_chars
+ */
+static void bench_chars(std::mt19937 &rng) {
+    std::cout << "\nmid-sized decimal conversion (us per call)\n";
+    std::cout << std::setw(10) << "digits" << std::setw(14) << "FixedPoint" << std::setw(14) << "from_chars"
+              << std::setw(14) << "to_string" << std::setw(14) << "to_chars" << "\n";
+    for (size_t n : {20, 100, 300}) {
+        std::string digits(n, '0');
+        for (char &c : digits) c = static_cast<char>('1' + rng() % 9);
+        std::string text = digits.substr(0, n / 4) + "." + digits.substr(n / 4);
+        // Дробь - 3.5 бита на цифру, с запасом
+        int frac_bits = static_cast<int>(n * 7 / 2);
+        FixedPoint value(text, frac_bits);
+        std::vector<char> out(to_chars_size(value));
+        std::cout << std::setw(10) << n << std::fixed << std::setprecision(3);
+        std::cout << std::setw(14) << time_us([&] { FixedPoint x(text, frac_bits); (void) x; });
+        std::cout << std::setw(14) << time_us([&] { from_chars(text, value, frac_bits); });
+        std::cout << std::setw(14) << time_us([&] { std::string s = value.to_string(); (void) s; });
+        std::cout << std::setw(14) << time_us([&] { to_chars(out.data(), out.data() + out.size(), value); });
+        std::cout << "\n";
+    }
+}
+
+/**
+ * @brief Основная функция программы
+ * @param argc Количество аргументов командной строки
+ * @param argv Массив аргументов командной строки
+ * @return Код завершения программы
+ *
+ * @details Без аргументов запускает все замеры, иначе только перечисленные:
+ * @code{.sh}
+ * ./benchmark tiers fixed
+ * @endcode
+ */
+int main(int argc, char** argv) {
+    std::mt19937 rng(42);
+    auto enabled = [&](const std::string &name) {
+        if (argc == 1) return true;
+        for (int i = 1; i < argc; ++i) {
+            if (name == argv[i]) return true;
+        }
+        return false;
+    };
+
+    if (enabled("basecase")) bench_mul_basecase(rng);
+    if (enabled("tiers")) bench_mul_tiers(rng);
+    if (enabled("sqr")) bench_sqr(rng);
+    if (enabled("ntt")) bench_ntt(rng, 10000000);
+    if (enabled("div")) bench_div(rng);
+    if (enabled("preinv")) bench_preinv(rng);
+    if (enabled("fixed")) bench_fixed_point_mul();
+    if (enabled("scalar")) bench_scalar_ops();
+    if (enabled("alloc")) bench_limb_resources();
+    if (enabled("static")) bench_static_fixed_point();
+    if (enabled("fused")) bench_fused_ops();
+    if (enabled("parse")) bench_parse(rng);
+    if (enabled("print")) bench_print(rng);
+    if (enabled("chars")) bench_chars(rng);
+    return 0;
+}
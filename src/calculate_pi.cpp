@@ -9,9 +9,84 @@
 #include <iostream>
 #include <string>
 #include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
 #include "../include/long_arithmetic.hpp"
 #include "../include/pi_calculation.hpp"
 
+/**
+ * @class DigitWriter
+ * @brief Пишет цифры в файловый дескриптор, собирая мелкие куски
+ *
+ * Знак, точка и короткие блоки копируются в промежуточный буфер, а
+ * длинный блок отправляется вместе с ним одним вызовом writev, без
+ * копирования.
+ */
+class DigitWriter {
+public:
+    /// Размер промежуточного буфера
+    static constexpr size_t STAGE_SIZE = 4096;
+
+    explicit DigitWriter(int fd) : fd(fd) { staged.reserve(STAGE_SIZE); }
+
+    /**
+     * @brief Добавляет n символов из data
+     * @throw std::runtime_error при ошибке записи
+     */
+    void write(const char *data, size_t n) {
+        if (staged.size() + n <= STAGE_SIZE) {
+            staged.insert(staged.end(), data, data + n);
+            return;
+        }
+        iovec parts[2] = {{staged.data(), staged.size()}, {const_cast<char *>(data), n}};
+        write_all(parts, 2);
+        staged.clear();
+    }
+
+    /**
+     * @brief Записывает накопленные символы
+     */
+    void flush() {
+        iovec part = {staged.data(), staged.size()};
+        write_all(&part, 1);
+        staged.clear();
+    }
+
+private:
+    int fd;                   ///< Файловый дескриптор
+    std::vector<char> staged; ///< Ещё не записанные символы
+
+    /**
+     * @brief Записывает части целиком, повторяя writev после неполной записи
+     */
+    void write_all(iovec *parts, int count) {
+        while (count > 0) {
+            ssize_t written = ::writev(fd, parts, count);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error(std::strerror(errno));
+            }
+            size_t rest = static_cast<size_t>(written);
+            while (count > 0 && rest >= parts->iov_len) {
+                rest -= parts->iov_len;
+                parts++;
+                count--;
+            }
+            if (count > 0) {
+                parts->iov_base = static_cast<char *>(parts->iov_base) + rest;
+                parts->iov_len -= rest;
+            }
+        }
+    }
+};
+
 
 /**
  * @brief Основная функция программы
@@ -19,15 +94,18 @@
  * @param argv Массив аргументов командной строки
  * @return Код завершения программы (0 - успех, 1 - ошибка)
  * 
- * @details Программа принимает один аргумент командной строки:
- * количество знаков после запятой для вывода числа π.
+ * @details Программа принимает аргументы командной строки:
+ * количество знаков после запятой для вывода числа π и необязательный
+ * путь к файлу, в который записываются цифры.
  * 
  * Пример использования:
  * @code{.sh}
  * ./pi_calculator 50
+ * ./pi_calculator 1000000 pi.txt
  * @endcode
  * 
- * Выведет число π с 50 знаками после запятой и время вычисления.
+ * Выведет число π с 50 знаками после запятой и время вычисления. Цифры
+ * не собираются в строку, а записываются блоками по мере перевода.
  */
 int main(int argc, char** argv) {
     if (argc == 1) {
@@ -41,13 +119,28 @@ int main(int argc, char** argv) {
         FixedPoint pi = get_pi();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>
                        (std::chrono::high_resolution_clock::now() - start);
-        std::string pi_str = pi.to_string();
-        pi_str.resize(len + 2);
-        std::cout << pi_str << std::endl;
+
+        int fd = STDOUT_FILENO;
+        if (argc > 2) {
+            fd = ::open(argv[2], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) {
+                throw std::runtime_error(std::string(argv[2]) + ": " + std::strerror(errno));
+            }
+        }
+        DigitWriter writer(fd);
+        pi.write_digits([&writer](const char *data, size_t n) { writer.write(data, n); }, len, false);
+        writer.write("\n", 1);
+        writer.flush();
+        if (fd != STDOUT_FILENO) {
+            ::close(fd);
+        }
         std::cout << "Total time (in ms) " << duration.count() << std::endl;
 
     } catch (const std::invalid_argument& e) {
         std::cerr << "Error: Invalid input." << std::endl;
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
     }
 
     return 0;
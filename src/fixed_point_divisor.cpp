@@ -0,0 +1,105 @@
+/**
+ * @file fixed_point_divisor.cpp
+ * @brief Реализация делителя FixedPoint с заранее вычисленным обратным
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "../include/fixed_point_divisor.hpp"
+#include "../include/limb_kernels.hpp"
+
+/**
+ * @brief Подготавливает делитель
+ * @param divisor Делитель
+ * @throw std::runtime_error если делитель равен нулю
+ * @details Лимбы делителя сдвигаются так, чтобы старший бит был
+ * установлен, и для них один раз вычисляется обратное.
+ */
+FixedPointDivisor::FixedPointDivisor(const FixedPoint &divisor) : divisor(divisor) {
+    normalized.assign(divisor.limb_data(), divisor.limb_data() + divisor.length);
+    normalized.resize(limbs::normalized_size(normalized.data(), normalized.size()));
+    if (normalized.empty()) {
+        throw std::runtime_error("Attempted division by zero");
+    }
+
+    shift = __builtin_clz(normalized.back());
+    if (shift != 0) {
+        limbs::lshift(normalized.data(), normalized.data(), normalized.size(), shift);
+    }
+
+    if (normalized.size() == 1) {
+        limb_inverse = limbs::invert_limb(normalized[0]);
+    } else if (normalized.size() >= limbs::DIV_PREINV_THRESHOLD) {
+        inverse.resize(normalized.size() + 1);
+        limbs::invert(inverse.data(), normalized.data(), normalized.size());
+    }
+}
+
+/**
+ * @brief Деление на подготовленный делитель
+ * @param dividend Делимое
+ * @return Частное с dividend.frac_limbs + divisor.frac_limbs лимбами дробной части
+ * @details Повторяет FixedPoint::divide: лимбы делимого дополняются снизу
+ * 2 * divisor.frac_limbs нулевыми лимбами и делятся нацело.
+ */
+FixedPoint FixedPointDivisor::divide(const FixedPoint &dividend) const {
+    LimbBuffer u(2 * divisor.frac_limbs + dividend.length);
+    std::copy(dividend.limb_data(), dividend.limb_data() + dividend.length, u.begin() + 2 * divisor.frac_limbs);
+
+    LimbBuffer q = quotient_limbs(u);
+
+    FixedPoint result;
+    result.assign_limbs(std::move(q), dividend.frac_limbs + divisor.frac_limbs);
+    if (result.frac_limbs == 0) {
+        result.extend_fraction(1);
+        result.fractional_bits = 32;
+    }
+    result.is_negative = dividend.is_negative ^ divisor.is_negative;
+
+    return result;
+}
+
+/**
+ * @brief Деление с остатком на подготовленный делитель
+ * @param dividend Делимое
+ * @return Пара: целое частное и остаток со знаком делимого
+ */
+std::pair<FixedPoint, FixedPoint> FixedPointDivisor::divmod(const FixedPoint &dividend) const {
+    FixedPoint quotient = divide(dividend);
+    quotient.set_precision(0);
+
+    FixedPoint remainder = dividend - (quotient * divisor);
+    remainder.is_negative = dividend.is_negative;
+
+    return {std::move(quotient), std::move(remainder)};
+}
+
+LimbBuffer FixedPointDivisor::quotient_limbs(const LimbBuffer &dividend) const {
+    size_t vn = normalized.size();
+    size_t un = limbs::normalized_size(dividend.data(), dividend.size());
+    LimbBuffer q(std::max(dividend.size(), un + 1));
+
+    if (vn == 1) {
+        limbs::divmod_1_preinv(q.data(), dividend.data(), un, normalized[0], limb_inverse, shift);
+    } else if (un >= vn) {
+        LimbBuffer u(un + 1);
+        if (shift != 0) {
+            u[un] = limbs::lshift(u.data(), dividend.data(), un, shift);
+        } else {
+            std::copy(dividend.begin(), dividend.begin() + un, u.begin());
+        }
+
+        if (!inverse.empty()) {
+            limbs::div_preinv(q.data(), u.data(), un + 1, normalized.data(), vn, inverse.data());
+        } else if (vn >= limbs::DIV_BZ_THRESHOLD && un + 1 - vn >= limbs::DIV_BZ_THRESHOLD) {
+            limbs::div_dc(q.data(), u.data(), un + 1, normalized.data(), vn);
+        } else {
+            limbs::div_basecase(q.data(), u.data(), un + 1, normalized.data(), vn);
+        }
+    }
+
+    q.resize(dividend.size());
+    return q;
+}
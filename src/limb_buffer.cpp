@@ -0,0 +1,151 @@
+/**
+ * @file limb_buffer.cpp
+ * @brief Реализация буфера лимбов со встроенным хранилищем
+ */
+
+#include <algorithm>
+
+#include "../include/limb_buffer.hpp"
+
+namespace {
+
+/// Ресурс для новых буферов лимбов в текущем потоке
+thread_local std::pmr::memory_resource *current_resource = std::pmr::new_delete_resource();
+
+} // namespace
+
+std::pmr::memory_resource *limb_resource() {
+    return current_resource;
+}
+
+std::pmr::memory_resource *limb_pool() {
+    thread_local std::pmr::unsynchronized_pool_resource pool(std::pmr::new_delete_resource());
+    return &pool;
+}
+
+LimbResourceScope::LimbResourceScope(std::pmr::memory_resource *resource) : previous(current_resource) {
+    current_resource = resource;
+}
+
+LimbResourceScope::~LimbResourceScope() {
+    current_resource = previous;
+}
+
+LimbBuffer::LimbBuffer(size_t count) {
+    resize(count);
+}
+
+LimbBuffer::LimbBuffer(const uint32_t *first, const uint32_t *last) {
+    assign(first, last);
+}
+
+LimbBuffer::LimbBuffer(const LimbBuffer &other) {
+    assign(other.begin(), other.end());
+}
+
+/**
+ * @details Данные в куче передаются вместе с указателем, встроенные -
+ * копируются. other остаётся пустым буфером со встроенным хранилищем.
+ */
+LimbBuffer::LimbBuffer(LimbBuffer &&other) noexcept : resource(other.resource) {
+    if (other.is_inline()) {
+        std::copy(other.begin(), other.end(), inline_limbs);
+    } else {
+        ptr = other.ptr;
+        cap = other.cap;
+        other.ptr = other.inline_limbs;
+        other.cap = INLINE_LIMBS;
+    }
+    count = other.count;
+    other.count = 0;
+}
+
+LimbBuffer &LimbBuffer::operator=(const LimbBuffer &other) {
+    if (this != &other) {
+        assign(other.begin(), other.end());
+    }
+    return *this;
+}
+
+LimbBuffer &LimbBuffer::operator=(LimbBuffer &&other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    if (other.is_inline()) {
+        // Встроенные данные копируются в уже имеющуюся память
+        std::copy(other.begin(), other.end(), ptr);
+    } else if (*resource != *other.resource) {
+        // Чужую память забрать нельзя: её нужно вернуть в другой ресурс
+        assign(other.begin(), other.end());
+        return *this;
+    } else {
+        release();
+        ptr = other.ptr;
+        cap = other.cap;
+        other.ptr = other.inline_limbs;
+        other.cap = INLINE_LIMBS;
+    }
+    count = other.count;
+    other.count = 0;
+    return *this;
+}
+
+LimbBuffer::~LimbBuffer() {
+    release();
+}
+
+void LimbBuffer::assign(const uint32_t *first, const uint32_t *last) {
+    size_t n = static_cast<size_t>(last - first);
+    if (n > cap) {
+        count = 0;
+        grow(n);
+    }
+    std::copy(first, last, ptr);
+    count = n;
+}
+
+void LimbBuffer::resize(size_t new_size) {
+    if (new_size > cap) {
+        grow(std::max(new_size, 2 * cap));
+    }
+    if (new_size > count) {
+        std::fill(ptr + count, ptr + new_size, 0);
+    }
+    count = new_size;
+}
+
+void LimbBuffer::reserve(size_t new_cap) {
+    if (new_cap > cap) {
+        grow(new_cap);
+    }
+}
+
+void LimbBuffer::push_back(uint32_t value) {
+    if (count == cap) {
+        grow(2 * cap);
+    }
+    ptr[count++] = value;
+}
+
+void LimbBuffer::insert_zeros(size_t zeros) {
+    if (count + zeros > cap) {
+        grow(std::max(count + zeros, 2 * cap));
+    }
+    std::copy_backward(ptr, ptr + count, ptr + count + zeros);
+    std::fill(ptr, ptr + zeros, 0);
+    count += zeros;
+}
+
+void LimbBuffer::grow(size_t min_cap) {
+    uint32_t *heap = static_cast<uint32_t *>(resource->allocate(min_cap * sizeof(uint32_t), alignof(uint32_t)));
+    std::copy(ptr, ptr + count, heap);
+    release();
+    ptr = heap;
+    cap = min_cap;
+}
+
+void LimbBuffer::release() {
+    if (!is_inline()) {
+        resource->deallocate(ptr, cap * sizeof(uint32_t), alignof(uint32_t));
+    }
+}
@@ -0,0 +1,314 @@
+/**
+ * @file limb_div.cpp
+ * @brief Деление массивов лимбов с остатком
+ *
+ * Делитель сдвигается так, чтобы его старший бит был установлен. Тогда
+ * оценка цифры частного по двум старшим лимбам остатка ошибается не
+ * больше чем на 2, и после проверки по второму лимбу делителя - не больше
+ * чем на 1.
+ *
+ * В среднем диапазоне длин деление рекурсивное (Буркинель - Циглер):
+ * старшая половина частного получается делением на старшую половину
+ * делителя, затем вычитается её произведение на младшую половину, так что
+ * стоимость определяется умножением половинной длины.
+ *
+ * Для длинных операндов частное получается умножением на обратное к
+ * делителю, которое вычисляется итерацией Ньютона с удвоением точности,
+ * поэтому стоимость деления следует за стоимостью limbs::mul.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "../include/limb_buffer.hpp"
+#include "../include/limb_kernels.hpp"
+
+namespace limbs {
+
+void div_basecase(limb_t *q, limb_t *u, size_t un, const limb_t *v, size_t vn) {
+    const dlimb_t base = static_cast<dlimb_t>(1) << 32;
+    const limb_t v1 = v[vn - 1], v2 = v[vn - 2];
+
+    for (size_t j = un - vn; j-- > 0;) {
+        limb_t *uj = u + j;
+        dlimb_t num = (static_cast<dlimb_t>(uj[vn]) << 32) | uj[vn - 1];
+        dlimb_t qhat = num / v1;
+        dlimb_t rhat = num % v1;
+
+        while (qhat >= base || qhat * v2 > ((rhat << 32) | uj[vn - 2])) {
+            --qhat;
+            rhat += v1;
+            if (rhat >= base) break;
+        }
+
+        limb_t borrow = submul_1(uj, v, vn, static_cast<limb_t>(qhat));
+        limb_t top = uj[vn];
+        uj[vn] = top - borrow;
+        if (top < borrow) {
+            // Оценка оказалась на единицу больше - возвращаем делитель
+            --qhat;
+            uj[vn] += add_n(uj, uj, v, vn);
+        }
+        q[j] = static_cast<limb_t>(qhat);
+    }
+}
+
+void invert(limb_t *x, const limb_t *v, size_t n) {
+    if (n < INV_NEWTON_THRESHOLD) {
+        std::vector<limb_t> u(2 * n + 1, 0), q(2 * n + 1);
+        u[2 * n] = 1;
+        if (n == 1) {
+            divmod_1(q.data(), u.data(), u.size(), v[0]);
+        } else {
+            div_basecase(q.data(), u.data(), u.size(), v, n);
+        }
+        std::copy(q.begin(), q.begin() + n + 1, x);
+        return;
+    }
+
+    // Обратное к старшим h лимбам даёт приближение с точностью около h лимбов
+    size_t h = (n + 1) / 2, l = n - h;
+    std::vector<limb_t> xh(h + 1);
+    invert(xh.data(), v + l, h);
+
+    // Шаг Ньютона: x = xh * B^l + xh * e / B^(2h), где e * B^l = B^(2n) - v * xh * B^l
+    std::vector<limb_t> p(n + h + 1), power(n + h + 1, 0);
+    mul(p.data(), v, n, xh.data(), h + 1);
+    power[n + h] = 1;
+
+    bool excess = cmp(p.data(), power.data(), n + h + 1) > 0;
+    std::vector<limb_t> e(n + h + 1);
+    if (excess) {
+        sub_n(e.data(), p.data(), power.data(), n + h + 1);
+    } else {
+        sub_n(e.data(), power.data(), p.data(), n + h + 1);
+    }
+    size_t en = normalized_size(e.data(), e.size());
+
+    std::vector<limb_t> w(n + 2, 0);
+    std::copy(xh.begin(), xh.end(), w.begin() + l);
+    if (en + 1 > h) {
+        std::vector<limb_t> c(h + 1 + en);
+        mul(c.data(), xh.data(), h + 1, e.data(), en);
+        size_t cn = std::min(c.size() - 2 * h, w.size());
+        if (excess) {
+            sub(w.data(), w.data(), w.size(), c.data() + 2 * h, cn);
+        } else {
+            add(w.data(), w.data(), w.size(), c.data() + 2 * h, cn);
+        }
+    }
+
+    // Приближение отличается от floor(B^(2n) / v) на несколько единиц - уточняем по остатку
+    std::vector<limb_t> vw(2 * n + 2), target(2 * n + 2, 0), next(2 * n + 2);
+    mul(vw.data(), w.data(), n + 2, v, n);
+    target[2 * n] = 1;
+    while (cmp(vw.data(), target.data(), vw.size()) > 0) {
+        sub_1(w.data(), w.data(), w.size(), 1);
+        sub(vw.data(), vw.data(), vw.size(), v, n);
+    }
+    while (true) {
+        add(next.data(), vw.data(), vw.size(), v, n);
+        if (cmp(next.data(), target.data(), next.size()) > 0) break;
+        add_1(w.data(), w.data(), w.size(), 1);
+        vw.swap(next);
+    }
+    std::copy(w.begin(), w.begin() + n + 1, x);
+}
+
+namespace {
+
+/**
+ * @brief Деление столбиком без требования, чтобы старшие vn лимбов были меньше v
+ * @return Старший лимб частного (0 или 1), остальные un - vn лимбов в q
+ */
+limb_t div_basecase_qh(limb_t *q, limb_t *u, size_t un, const limb_t *v, size_t vn) {
+    limb_t qh = 0;
+    if (cmp(u + un - vn, v, vn) >= 0) {
+        sub_n(u + un - vn, u + un - vn, v, vn);
+        qh = 1;
+    }
+    div_basecase(q, u, un, v, vn);
+    return qh;
+}
+
+/**
+ * @brief Рекурсивное деление 2n лимбов на n лимбов (Буркинель - Циглер)
+ * @param q Частное (n лимбов)
+ * @param u Делимое (2n лимбов), на выходе младшие n лимбов - остаток
+ * @param v Нормализованный делитель (n лимбов)
+ * @param tp Рабочий буфер (n лимбов)
+ * @return Старший лимб частного (0 или 1)
+ *
+ * @details Каждая половина частного делится на старшую половину делителя,
+ * затем из остатка вычитается произведение этой половины частного на
+ * младшую половину делителя. Оценка половины частного может оказаться
+ * больше точной на несколько единиц и исправляется обратным сложением.
+ */
+limb_t div_dc_n(limb_t *q, limb_t *u, const limb_t *v, size_t n, limb_t *tp) {
+    size_t lo = n / 2, hi = n - lo;
+
+    limb_t qh = hi < DIV_BZ_THRESHOLD ? div_basecase_qh(q + lo, u + 2 * lo, 2 * hi, v + lo, hi)
+                                      : div_dc_n(q + lo, u + 2 * lo, v + lo, hi, tp);
+    mul(tp, q + lo, hi, v, lo);
+    limb_t cy = sub_n(u + lo, u + lo, tp, n);
+    if (qh != 0) cy += sub_n(u + n, u + n, v, lo);
+    while (cy != 0) {
+        qh -= sub_1(q + lo, q + lo, hi, 1);
+        cy -= add_n(u + lo, u + lo, v, n);
+    }
+
+    limb_t ql = lo < DIV_BZ_THRESHOLD ? div_basecase_qh(q, u + hi, 2 * lo, v + hi, lo)
+                                      : div_dc_n(q, u + hi, v + hi, lo, tp);
+    mul(tp, v, hi, q, lo);
+    cy = sub_n(u, u, tp, n);
+    if (ql != 0) cy += sub_n(u + lo, u + lo, v, hi);
+    while (cy != 0) {
+        sub_1(q, q, lo, 1);
+        cy -= add_n(u, u, v, n);
+    }
+
+    return qh;
+}
+
+/**
+ * @brief Делит окно из qc + vn лимбов на v умножением на обратное
+ * @param q Частное (qc лимбов)
+ * @param u Окно делимого, старшие vn лимбов меньше v; на выходе младшие vn лимбов - остаток
+ * @param x Обратное к старшим k лимбам v (k + 1 лимбов), qc <= k <= vn
+ *
+ * @details Оценка частного отличается от точного значения на несколько
+ * единиц и исправляется по остатку в обе стороны.
+ */
+void div_chunk(limb_t *q, limb_t *u, size_t qc, const limb_t *v, size_t vn, const limb_t *x, size_t k) {
+    size_t un = qc + vn;
+
+    std::vector<limb_t> t(qc + k + 1);
+    mul(t.data(), u + vn, qc, x, k + 1);
+    std::vector<limb_t> qe(t.begin() + k, t.end());
+
+    std::vector<limb_t> p(un + 1), w(u, u + un);
+    w.push_back(0);
+    mul(p.data(), qe.data(), qc + 1, v, vn);
+    while (cmp(p.data(), w.data(), un + 1) > 0) {
+        sub_1(qe.data(), qe.data(), qc + 1, 1);
+        sub(p.data(), p.data(), un + 1, v, vn);
+    }
+    sub_n(w.data(), w.data(), p.data(), un + 1);
+    while (normalized_size(w.data() + vn, qc + 1) != 0 || cmp(w.data(), v, vn) >= 0) {
+        add_1(qe.data(), qe.data(), qc + 1, 1);
+        sub(w.data(), w.data(), un + 1, v, vn);
+    }
+
+    std::copy(w.begin(), w.begin() + un, u);
+    std::copy(qe.begin(), qe.begin() + qc, q);
+}
+
+} // namespace
+
+void div_newton(limb_t *q, limb_t *u, size_t un, const limb_t *v, size_t vn) {
+    size_t pos = un - vn;
+    std::vector<limb_t> x_full;
+
+    // Старший (неполный) блок частного, затем блоки по vn лимбов
+    size_t qc = pos % vn != 0 ? pos % vn : vn;
+    while (pos > 0) {
+        size_t k = std::min(vn, qc + 1);
+        std::vector<limb_t> x_part;
+        const limb_t *x;
+        if (k == vn) {
+            if (x_full.empty()) {
+                x_full.resize(vn + 1);
+                invert(x_full.data(), v, vn);
+            }
+            x = x_full.data();
+        } else {
+            x_part.resize(k + 1);
+            invert(x_part.data(), v + vn - k, k);
+            x = x_part.data();
+        }
+
+        pos -= qc;
+        div_chunk(q + pos, u + pos, qc, v, vn, x, k);
+        qc = vn;
+    }
+}
+
+void div_dc(limb_t *q, limb_t *u, size_t un, const limb_t *v, size_t vn) {
+    LimbBuffer tp(vn);
+    size_t pos = un - vn;
+
+    // Неполный старший блок частного: qc старших лимбов делятся на старшие qc лимбов делителя
+    size_t qc = pos % vn;
+    if (qc != 0) {
+        pos -= qc;
+        limb_t *w = u + pos;
+        if (qc < DIV_BZ_THRESHOLD) {
+            div_basecase(q + pos, w, qc + vn, v, vn);
+        } else {
+            size_t lo = vn - qc;
+            limb_t qh = div_dc_n(q + pos, w + lo, v + lo, qc, tp.data());
+            mul(tp.data(), q + pos, qc, v, lo);
+            limb_t cy = sub_n(w, w, tp.data(), vn);
+            if (qh != 0) cy += sub_n(w + qc, w + qc, v, lo);
+            while (cy != 0) {
+                qh -= sub_1(q + pos, q + pos, qc, 1);
+                cy -= add_n(w, w, v, vn);
+            }
+        }
+    }
+
+    while (pos > 0) {
+        pos -= vn;
+        div_dc_n(q + pos, u + pos, v, vn, tp.data());
+    }
+}
+
+void div_preinv(limb_t *q, limb_t *u, size_t un, const limb_t *v, size_t vn, const limb_t *x) {
+    size_t pos = un - vn;
+    size_t qc = pos % vn != 0 ? pos % vn : vn;
+    while (pos > 0) {
+        pos -= qc;
+        div_chunk(q + pos, u + pos, qc, v, vn, x, vn);
+        qc = vn;
+    }
+}
+
+void divrem(limb_t *q, limb_t *r, const limb_t *a, size_t an, const limb_t *d, size_t dn) {
+    if (dn == 1) {
+        limb_t rem = divmod_1(q, a, an, d[0]);
+        if (r != nullptr) r[0] = rem;
+        return;
+    }
+
+    unsigned shift = __builtin_clz(d[dn - 1]);
+
+    // Короткие операнды нормализуются во встроенных буферах, без кучи
+    LimbBuffer v(d, d + dn);
+    LimbBuffer u(an + 1);
+    if (shift != 0) {
+        lshift(v.data(), d, dn, shift);
+        u[an] = lshift(u.data(), a, an, shift);
+    } else {
+        std::copy(a, a + an, u.begin());
+        u[an] = 0;
+    }
+
+    size_t qn = an + 1 - dn;
+    if (dn >= DIV_NEWTON_THRESHOLD && qn >= DIV_NEWTON_THRESHOLD) {
+        div_newton(q, u.data(), an + 1, v.data(), dn);
+    } else if (dn >= DIV_BZ_THRESHOLD && qn >= DIV_BZ_THRESHOLD) {
+        div_dc(q, u.data(), an + 1, v.data(), dn);
+    } else {
+        div_basecase(q, u.data(), an + 1, v.data(), dn);
+    }
+
+    if (r != nullptr) {
+        if (shift != 0) {
+            rshift(r, u.data(), dn, shift);
+        } else {
+            std::copy(u.begin(), u.begin() + dn, r);
+        }
+    }
+}
+
+} // namespace limbs
@@ -0,0 +1,298 @@
+/**
+ * @file limb_kernels.cpp
+ * @brief Реализация низкоуровневых операций над массивами лимбов
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#include "../include/limb_kernels.hpp"
+
+namespace limbs {
+
+// Основной цикл сложения и вычитания обрабатывает по четыре лимба как два
+// 64-битных слова: на x86-64 перенос идёт по цепочке adc/sbb, остаток
+// длины и другие архитектуры - по одному лимбу в 64-битной арифметике.
+limb_t add_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    size_t i = 0;
+    dlimb_t carry = 0;
+#if defined(__x86_64__)
+    unsigned char c = 0;
+    for (; i + 4 <= n; i += 4) {
+        unsigned long long x0, x1, y0, y1;
+        std::memcpy(&x0, a + i, 8);
+        std::memcpy(&x1, a + i + 2, 8);
+        std::memcpy(&y0, b + i, 8);
+        std::memcpy(&y1, b + i + 2, 8);
+        c = _addcarry_u64(c, x0, y0, &x0);
+        c = _addcarry_u64(c, x1, y1, &x1);
+        std::memcpy(r + i, &x0, 8);
+        std::memcpy(r + i + 2, &x1, 8);
+    }
+    carry = c;
+#endif
+    for (; i < n; ++i) {
+        carry += static_cast<dlimb_t>(a[i]) + b[i];
+        r[i] = static_cast<limb_t>(carry);
+        carry >>= 32;
+    }
+    return static_cast<limb_t>(carry);
+}
+
+limb_t sub_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    size_t i = 0;
+    limb_t borrow = 0;
+#if defined(__x86_64__)
+    unsigned char c = 0;
+    for (; i + 4 <= n; i += 4) {
+        unsigned long long x0, x1, y0, y1;
+        std::memcpy(&x0, a + i, 8);
+        std::memcpy(&x1, a + i + 2, 8);
+        std::memcpy(&y0, b + i, 8);
+        std::memcpy(&y1, b + i + 2, 8);
+        c = _subborrow_u64(c, x0, y0, &x0);
+        c = _subborrow_u64(c, x1, y1, &x1);
+        std::memcpy(r + i, &x0, 8);
+        std::memcpy(r + i + 2, &x1, 8);
+    }
+    borrow = c;
+#endif
+    for (; i < n; ++i) {
+        dlimb_t diff = static_cast<dlimb_t>(a[i]) - b[i] - borrow;
+        r[i] = static_cast<limb_t>(diff);
+        borrow = static_cast<limb_t>(diff >> 63);
+    }
+    return borrow;
+}
+
+limb_t add_1(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    size_t i = 0;
+    for (; i < n && b != 0; ++i) {
+        r[i] = a[i] + b;
+        b = r[i] < b;
+    }
+    if (r != a) std::copy(a + i, a + n, r + i);
+    return b;
+}
+
+limb_t sub_1(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    size_t i = 0;
+    for (; i < n && b != 0; ++i) {
+        limb_t val = a[i];
+        r[i] = val - b;
+        b = val < b;
+    }
+    if (r != a) std::copy(a + i, a + n, r + i);
+    return b;
+}
+
+limb_t add(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    limb_t carry = add_n(r, a, b, bn);
+    return add_1(r + bn, a + bn, an - bn, carry);
+}
+
+limb_t sub(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    limb_t borrow = sub_n(r, a, b, bn);
+    return sub_1(r + bn, a + bn, an - bn, borrow);
+}
+
+int cmp(const limb_t *a, const limb_t *b, size_t n) {
+    while (n-- > 0) {
+        if (a[n] != b[n]) return a[n] > b[n] ? 1 : -1;
+    }
+    return 0;
+}
+
+size_t normalized_size(const limb_t *a, size_t n) {
+    while (n > 0 && a[n - 1] == 0) --n;
+    return n;
+}
+
+limb_t invert_limb(limb_t d) {
+    return static_cast<limb_t>(((static_cast<dlimb_t>(~d) << 32) | 0xFFFFFFFF) / d);
+}
+
+limb_t divmod_1_preinv(limb_t *q, const limb_t *a, size_t n, limb_t d, limb_t dinv, unsigned shift) {
+    if (n == 0) return 0;
+
+    // Деление двух лимбов (u1 < d) на нормализованный d по Мёллеру - Гранлунду
+    auto div_2by1 = [d, dinv](limb_t u1, limb_t u0, limb_t &r) {
+        dlimb_t p = static_cast<dlimb_t>(dinv) * u1 + ((static_cast<dlimb_t>(u1) << 32) | u0);
+        limb_t q1 = static_cast<limb_t>(p >> 32) + 1;
+        limb_t q0 = static_cast<limb_t>(p);
+        r = u0 - q1 * d;
+        if (r > q0) {
+            --q1;
+            r += d;
+        }
+        if (r >= d) {
+            ++q1;
+            r -= d;
+        }
+        return q1;
+    };
+
+    // При shift != 0 делимое сдвигается на лету: делится a * 2^shift на d
+    limb_t r = shift != 0 ? a[n - 1] >> (32 - shift) : 0;
+    for (size_t i = n; i-- > 0;) {
+        limb_t u0 = a[i] << shift;
+        if (shift != 0 && i > 0) u0 |= a[i - 1] >> (32 - shift);
+        q[i] = div_2by1(r, u0, r);
+    }
+    return r >> shift;
+}
+
+limb_t divmod_1(limb_t *q, const limb_t *a, size_t n, limb_t d) {
+    unsigned shift = __builtin_clz(d);
+    d <<= shift;
+    return divmod_1_preinv(q, a, n, d, invert_limb(d), shift);
+}
+
+dlimb_t divmod_2(limb_t *q, const limb_t *a, size_t n, dlimb_t d) {
+    // Остаток меньше d, поэтому каждая цифра частного помещается в лимб
+    dlimb_t rem = 0;
+    while (n-- > 0) {
+        unsigned __int128 cur = (static_cast<unsigned __int128>(rem) << 32) | a[n];
+        q[n] = static_cast<limb_t>(cur / d);
+        rem = static_cast<dlimb_t>(cur % d);
+    }
+    return rem;
+}
+
+void divexact_1(limb_t *q, const limb_t *a, size_t n, limb_t d) {
+    int shift = 0;
+    while ((d & 1) == 0) {
+        d >>= 1;
+        ++shift;
+    }
+
+    // Обратный к нечётному d по модулю 2^32 (итерации Ньютона)
+    limb_t inv = d;
+    for (int i = 0; i < 5; ++i) inv *= 2 - d * inv;
+
+    limb_t borrow = 0;
+    for (size_t i = 0; i < n; ++i) {
+        limb_t cur = a[i];
+        if (shift != 0 && i + 1 < n) cur = (cur >> shift) | (a[i + 1] << (32 - shift));
+        else if (shift != 0) cur >>= shift;
+
+        limb_t x = cur - borrow;
+        limb_t under = cur < borrow;
+        q[i] = x * inv;
+        borrow = static_cast<limb_t>((static_cast<dlimb_t>(q[i]) * d) >> 32) + under;
+    }
+}
+
+limb_t lshift(limb_t *r, const limb_t *a, size_t n, unsigned cnt) {
+    if (n == 0) return 0;
+    limb_t out = a[n - 1] >> (32 - cnt);
+    for (size_t i = n - 1; i > 0; --i) {
+        r[i] = (a[i] << cnt) | (a[i - 1] >> (32 - cnt));
+    }
+    r[0] = a[0] << cnt;
+    return out;
+}
+
+limb_t rshift(limb_t *r, const limb_t *a, size_t n, unsigned cnt) {
+    if (n == 0) return 0;
+    limb_t out = a[0] << (32 - cnt);
+    for (size_t i = 0; i + 1 < n; ++i) {
+        r[i] = (a[i] >> cnt) | (a[i + 1] << (32 - cnt));
+    }
+    r[n - 1] = a[n - 1] >> cnt;
+    return out;
+}
+
+limb_t mul_1(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    dlimb_t carry = 0;
+    for (size_t i = 0; i < n; ++i) {
+        carry += static_cast<dlimb_t>(a[i]) * b;
+        r[i] = static_cast<limb_t>(carry);
+        carry >>= 32;
+    }
+    return static_cast<limb_t>(carry);
+}
+
+limb_t addmul_1(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    // a[i] * b + r[i] + carry <= 2^64 - 1, поэтому аккумулятор не переполняется
+    dlimb_t carry = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        carry += static_cast<dlimb_t>(a[i]) * b + r[i];
+        r[i] = static_cast<limb_t>(carry);
+        carry >>= 32;
+        carry += static_cast<dlimb_t>(a[i + 1]) * b + r[i + 1];
+        r[i + 1] = static_cast<limb_t>(carry);
+        carry >>= 32;
+        carry += static_cast<dlimb_t>(a[i + 2]) * b + r[i + 2];
+        r[i + 2] = static_cast<limb_t>(carry);
+        carry >>= 32;
+        carry += static_cast<dlimb_t>(a[i + 3]) * b + r[i + 3];
+        r[i + 3] = static_cast<limb_t>(carry);
+        carry >>= 32;
+    }
+    for (; i < n; ++i) {
+        carry += static_cast<dlimb_t>(a[i]) * b + r[i];
+        r[i] = static_cast<limb_t>(carry);
+        carry >>= 32;
+    }
+    return static_cast<limb_t>(carry);
+}
+
+limb_t submul_1(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    dlimb_t carry = 0;
+    for (size_t i = 0; i < n; ++i) {
+        carry += static_cast<dlimb_t>(a[i]) * b;
+        limb_t lo = static_cast<limb_t>(carry);
+        carry >>= 32;
+        carry += r[i] < lo;
+        r[i] -= lo;
+    }
+    return static_cast<limb_t>(carry);
+}
+
+void mul_basecase(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    size_t rn = an + bn;
+    std::fill(r, r + rn, 0);
+
+    for (size_t j0 = 0; j0 < bn; j0 += MUL_BLOCK_LIMBS) {
+        size_t blk = std::min(MUL_BLOCK_LIMBS, bn - j0);
+        for (size_t i = 0; i < an; ++i) {
+            limb_t carry = addmul_1(r + i + j0, b + j0, blk, a[i]);
+
+            // Старшие лимбы уже могли быть заполнены предыдущими блоками
+            for (size_t k = i + j0 + blk; carry != 0 && k < rn; ++k) {
+                r[k] += carry;
+                carry = r[k] < carry;
+            }
+        }
+    }
+}
+
+void sqr_basecase(limb_t *r, const limb_t *a, size_t n) {
+    size_t rn = 2 * n;
+    std::fill(r, r + rn, 0);
+
+    // Произведения a[i] * a[j] при i < j, строка i заканчивается в r[i + n]
+    for (size_t i = 0; i + 1 < n; ++i) {
+        r[i + n] = addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+    }
+    lshift(r, r, rn, 1);
+
+    dlimb_t carry = 0;
+    for (size_t i = 0; i < n; ++i) {
+        dlimb_t sq = static_cast<dlimb_t>(a[i]) * a[i];
+        carry += static_cast<dlimb_t>(r[2 * i]) + static_cast<limb_t>(sq);
+        r[2 * i] = static_cast<limb_t>(carry);
+        carry >>= 32;
+        carry += static_cast<dlimb_t>(r[2 * i + 1]) + (sq >> 32);
+        r[2 * i + 1] = static_cast<limb_t>(carry);
+        carry >>= 32;
+    }
+}
+
+} // namespace limbs
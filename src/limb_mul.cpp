@@ -0,0 +1,338 @@
+/**
+ * @file limb_mul.cpp
+ * @brief Быстрые алгоритмы умножения лимбовых массивов и выбор между ними
+ */
+
+#include <algorithm>
+
+#include "../include/limb_buffer.hpp"
+#include "../include/limb_kernels.hpp"
+
+namespace limbs {
+
+namespace {
+
+/**
+ * @brief Знаковое число для промежуточных значений алгоритмов Тоома
+ *
+ * Модуль хранится без старших нулевых лимбов, пустой модуль означает ноль.
+ */
+struct Signed {
+    LimbBuffer mag;
+    bool neg = false;
+};
+
+/// Наибольшее число точек: 2k - 1 для Тоома-4
+constexpr size_t TOOM_MAX_POINTS = 7;
+
+void trim(LimbBuffer &v) {
+    v.resize(normalized_size(v.data(), v.size()));
+}
+
+int cmp_mag(const LimbBuffer &a, const LimbBuffer &b) {
+    if (a.size() != b.size()) return a.size() > b.size() ? 1 : -1;
+    return cmp(a.data(), b.data(), a.size());
+}
+
+LimbBuffer add_mag(const LimbBuffer &a, const LimbBuffer &b) {
+    const LimbBuffer &x = (a.size() >= b.size() ? a : b);
+    const LimbBuffer &y = (a.size() >= b.size() ? b : a);
+    LimbBuffer r(x.size() + 1);
+    r[x.size()] = add(r.data(), x.data(), x.size(), y.data(), y.size());
+    trim(r);
+    return r;
+}
+
+// |a| - |b| при |a| >= |b|
+LimbBuffer sub_mag(const LimbBuffer &a, const LimbBuffer &b) {
+    LimbBuffer r(a.size());
+    sub(r.data(), a.data(), a.size(), b.data(), b.size());
+    trim(r);
+    return r;
+}
+
+Signed add_signed(const Signed &a, const Signed &b) {
+    if (a.neg == b.neg) return {add_mag(a.mag, b.mag), a.neg};
+    int c = cmp_mag(a.mag, b.mag);
+    if (c == 0) return {};
+    if (c > 0) return {sub_mag(a.mag, b.mag), a.neg};
+    return {sub_mag(b.mag, a.mag), b.neg};
+}
+
+Signed sub_signed(const Signed &a, Signed b) {
+    b.neg = !b.neg && !b.mag.empty();
+    return add_signed(a, b);
+}
+
+void mul_small(Signed &a, int v) {
+    if (v == 0 || a.mag.empty()) {
+        a = Signed{};
+        return;
+    }
+    limb_t uv = static_cast<limb_t>(v < 0 ? -v : v);
+    a.mag.push_back(mul_1(a.mag.data(), a.mag.data(), a.mag.size(), uv));
+    trim(a.mag);
+    a.neg = a.neg ^ (v < 0);
+}
+
+// Деление, про которое заранее известно, что оно без остатка
+void divexact_small(Signed &a, int v) {
+    limb_t uv = static_cast<limb_t>(v < 0 ? -v : v);
+    divexact_1(a.mag.data(), a.mag.data(), a.mag.size(), uv);
+    trim(a.mag);
+    a.neg = (a.neg ^ (v < 0)) && !a.mag.empty();
+}
+
+Signed mul_signed(const Signed &a, const Signed &b) {
+    if (a.mag.empty() || b.mag.empty()) return {};
+    Signed r;
+    r.mag.resize(a.mag.size() + b.mag.size());
+    mul(r.mag.data(), a.mag.data(), a.mag.size(), b.mag.data(), b.mag.size());
+    trim(r.mag);
+    r.neg = a.neg ^ b.neg;
+    return r;
+}
+
+Signed sqr_signed(const Signed &a) {
+    if (a.mag.empty()) return {};
+    Signed r;
+    r.mag.resize(2 * a.mag.size());
+    sqr(r.mag.data(), a.mag.data(), a.mag.size());
+    trim(r.mag);
+    return r;
+}
+
+// Значение многочлена из k коэффициентов-частей числа в точке x (схема Горнера)
+Signed evaluate(const Signed *parts, size_t k, int x) {
+    Signed val = parts[k - 1];
+    for (size_t i = k - 1; i-- > 0;) {
+        mul_small(val, x);
+        val = add_signed(val, parts[i]);
+    }
+    return val;
+}
+
+void split(Signed *parts, const limb_t *a, size_t an, size_t len, size_t k) {
+    for (size_t i = 0; i < k && i * len < an; ++i) {
+        size_t sz = std::min(len, an - i * len);
+        parts[i].mag.assign(a + i * len, a + i * len + sz);
+        trim(parts[i].mag);
+    }
+}
+
+/**
+ * @brief Общая схема Тоома-k с целыми точками 0, 1, -1, 2, -2, ...
+ *
+ * Произведение многочленов восстанавливается по 2k - 1 значениям через
+ * разделённые разности Ньютона. Для целочисленного многочлена в целых
+ * узлах все разделённые разности целые, поэтому каждое деление точное.
+ * При b == nullptr вычисляется квадрат a: значения в точках возводятся в квадрат.
+ * Массивы значений и коэффициентов лежат на стеке, их модули - в LimbBuffer,
+ * поэтому память берётся из limb_resource().
+ */
+void mul_toom(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn, size_t k) {
+    static const int nodes[TOOM_MAX_POINTS] = {0, 1, -1, 2, -2, 3, -3};
+    bool square = (b == nullptr);
+    if (square) bn = an;
+    size_t len = (an + k - 1) / k;
+    size_t m = 2 * k - 1;
+
+    Signed a_parts[TOOM_MAX_POINTS / 2 + 1], b_parts[TOOM_MAX_POINTS / 2 + 1];
+    split(a_parts, a, an, len, k);
+    if (!square) split(b_parts, b, bn, len, k);
+
+    Signed v[TOOM_MAX_POINTS];
+    for (size_t i = 0; i < m; ++i) {
+        Signed a_val = evaluate(a_parts, k, nodes[i]);
+        v[i] = square ? sqr_signed(a_val) : mul_signed(a_val, evaluate(b_parts, k, nodes[i]));
+    }
+
+    // Разделённые разности: v[i] становится коэффициентом формы Ньютона
+    for (size_t j = 1; j < m; ++j) {
+        for (size_t i = m - 1; i >= j; --i) {
+            v[i] = sub_signed(v[i], v[i - 1]);
+            divexact_small(v[i], nodes[i] - nodes[i - j]);
+        }
+    }
+
+    // Переход от формы Ньютона к обычным коэффициентам
+    Signed coef[TOOM_MAX_POINTS], next[TOOM_MAX_POINTS];
+    size_t coef_n = 1;
+    coef[0] = v[m - 1];
+    for (size_t i = m - 1; i-- > 0;) {
+        for (size_t j = 0; j <= coef_n; ++j) {
+            next[j] = Signed{};
+        }
+        for (size_t j = 0; j < coef_n; ++j) {
+            next[j + 1] = add_signed(next[j + 1], coef[j]);
+            Signed scaled = coef[j];
+            mul_small(scaled, nodes[i]);
+            next[j] = sub_signed(next[j], scaled);
+        }
+        next[0] = add_signed(next[0], v[i]);
+        coef_n++;
+        for (size_t j = 0; j < coef_n; ++j) {
+            std::swap(coef[j], next[j]);
+        }
+    }
+
+    // Коэффициенты произведения неотрицательны, складываем их со сдвигом
+    size_t rn = an + bn;
+    std::fill(r, r + rn, 0);
+    for (size_t j = 0; j < coef_n && j * len < rn; ++j) {
+        const LimbBuffer &c = coef[j].mag;
+        size_t room = rn - j * len;
+        if (c.empty()) continue;
+        add(r + j * len, r + j * len, room, c.data(), std::min(c.size(), room));
+    }
+}
+
+// Модуль разности a (n лимбов) и b (bn <= n лимбов), возвращает true при a < b
+bool abs_diff(limb_t *r, const limb_t *a, size_t n, const limb_t *b, size_t bn) {
+    size_t b_top = normalized_size(b, bn);
+    bool less = normalized_size(a, n) < b_top ||
+                (normalized_size(a, n) == b_top && cmp(a, b, b_top) < 0);
+    if (less) {
+        std::fill(r + bn, r + n, 0);
+        sub(r, b, bn, a, bn);
+    } else {
+        sub(r, a, n, b, bn);
+    }
+    return less;
+}
+
+} // namespace
+
+void mul_karatsuba(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    size_t k = (an + 1) / 2;
+    size_t a1n = an - k, b1n = bn - k;
+    size_t rn = an + bn;
+
+    LimbBuffer da(k), db(k), t(2 * k), mid(2 * k + 1);
+
+    bool a_neg = abs_diff(da.data(), a, k, a + k, a1n);
+    bool b_neg = abs_diff(db.data(), b, k, b + k, b1n);
+
+    mul(r, a, k, b, k);
+    mul(r + 2 * k, a + k, a1n, b + k, b1n);
+    mul(t.data(), da.data(), k, db.data(), k);
+
+    // mid = a0*b1 + a1*b0 = z0 + z2 - (a0 - a1)(b0 - b1)
+    std::copy(r, r + 2 * k, mid.begin());
+    mid[2 * k] = add(mid.data(), mid.data(), 2 * k, r + 2 * k, a1n + b1n);
+    if (a_neg != b_neg) {
+        add(mid.data(), mid.data(), 2 * k + 1, t.data(), 2 * k);
+    } else {
+        sub(mid.data(), mid.data(), 2 * k + 1, t.data(), 2 * k);
+    }
+
+    add(r + k, r + k, rn - k, mid.data(), std::min(2 * k + 1, rn - k));
+}
+
+void sqr_karatsuba(limb_t *r, const limb_t *a, size_t n) {
+    size_t k = (n + 1) / 2;
+    size_t a1n = n - k;
+
+    LimbBuffer d(k), t(2 * k), mid(2 * k + 1);
+    abs_diff(d.data(), a, k, a + k, a1n);
+
+    sqr(r, a, k);
+    sqr(r + 2 * k, a + k, a1n);
+    sqr(t.data(), d.data(), k);
+
+    // mid = 2 * a0 * a1 = z0 + z2 - (a0 - a1)^2
+    std::copy(r, r + 2 * k, mid.begin());
+    mid[2 * k] = add(mid.data(), mid.data(), 2 * k, r + 2 * k, 2 * a1n);
+    sub(mid.data(), mid.data(), 2 * k + 1, t.data(), 2 * k);
+
+    add(r + k, r + k, 2 * n - k, mid.data(), std::min(2 * k + 1, 2 * n - k));
+}
+
+void mul_toom3(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    mul_toom(r, a, an, b, bn, 3);
+}
+
+void mul_toom4(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    mul_toom(r, a, an, b, bn, 4);
+}
+
+void sqr_toom3(limb_t *r, const limb_t *a, size_t n) {
+    mul_toom(r, a, n, nullptr, n, 3);
+}
+
+void sqr_toom4(limb_t *r, const limb_t *a, size_t n) {
+    mul_toom(r, a, n, nullptr, n, 4);
+}
+
+void sqr(limb_t *r, const limb_t *a, size_t n) {
+    if (n == 0) return;
+    if (n == 1) {
+        dlimb_t sq = static_cast<dlimb_t>(a[0]) * a[0];
+        r[0] = static_cast<limb_t>(sq);
+        r[1] = static_cast<limb_t>(sq >> 32);
+        return;
+    }
+    if (n < SQR_KARATSUBA_THRESHOLD) {
+        sqr_basecase(r, a, n);
+    } else if (n >= NTT_THRESHOLD && 2 * n <= NTT_MAX_LIMBS) {
+        sqr_ntt(r, a, n);
+    } else if (n < TOOM3_THRESHOLD) {
+        sqr_karatsuba(r, a, n);
+    } else if (n < TOOM4_THRESHOLD) {
+        sqr_toom3(r, a, n);
+    } else {
+        sqr_toom4(r, a, n);
+    }
+}
+
+void mul(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    if (a == b && an == bn) {
+        sqr(r, a, an);
+        return;
+    }
+    if (an < bn) {
+        std::swap(a, b);
+        std::swap(an, bn);
+    }
+    if (bn == 0) {
+        std::fill(r, r + an, 0);
+        return;
+    }
+    if (bn == 1) {
+        r[an] = mul_1(r, a, an, b[0]);
+        return;
+    }
+    if (bn < KARATSUBA_THRESHOLD) {
+        // Строки столбика идут по короткому множителю, блоки - по длинному
+        mul_basecase(r, b, bn, a, an);
+        return;
+    }
+
+    if (bn >= NTT_THRESHOLD && an + bn <= NTT_MAX_LIMBS) {
+        mul_ntt(r, a, an, b, bn);
+        return;
+    }
+
+    // Сильно несбалансированные операнды: режем длинный на куски длины bn
+    if (bn <= (an + 1) / 2) {
+        size_t rn = an + bn;
+        std::fill(r, r + rn, 0);
+        LimbBuffer piece(2 * bn);
+        for (size_t off = 0; off < an; off += bn) {
+            size_t len = std::min(bn, an - off);
+            mul(piece.data(), a + off, len, b, bn);
+            add(r + off, r + off, rn - off, piece.data(), len + bn);
+        }
+        return;
+    }
+
+    if (bn < TOOM3_THRESHOLD) {
+        mul_karatsuba(r, a, an, b, bn);
+    } else if (bn < TOOM4_THRESHOLD) {
+        mul_toom3(r, a, an, b, bn);
+    } else {
+        mul_toom4(r, a, an, b, bn);
+    }
+}
+
+} // namespace limbs
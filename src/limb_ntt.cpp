@@ -0,0 +1,206 @@
+/**
+ * @file limb_ntt.cpp
+ * @brief Умножение через теоретико-числовое преобразование (NTT) по трём простым модулям
+ *
+ * Лимбы операндов считаются коэффициентами многочленов, их свёртка
+ * вычисляется по модулю трёх простых чисел вида c * 2^k + 1 и
+ * восстанавливается китайской теоремой об остатках. Произведение модулей
+ * больше 2^90, а коэффициент свёртки не превосходит min(an, bn) * 2^64,
+ * поэтому результат точный при an + bn <= NTT_MAX_LIMBS.
+ */
+
+#include <algorithm>
+
+#include "../include/limb_buffer.hpp"
+#include "../include/limb_kernels.hpp"
+
+namespace limbs {
+
+namespace {
+
+/**
+ * @brief Арифметика по простому модулю p < 2^31 в форме Монтгомери (R = 2^32)
+ *
+ * Данные преобразования хранятся в обычном виде, в форме Монтгомери
+ * только корни из единицы, поэтому mont_mul(x, w) сразу даёт x * w mod p.
+ */
+struct Modulus {
+    limb_t p;          ///< Простой модуль
+    limb_t root;       ///< Первообразный корень по модулю p
+    limb_t p_inv_neg;  ///< -p^(-1) mod 2^32
+    limb_t r2;         ///< R^2 mod p
+
+    explicit Modulus(limb_t prime, limb_t generator) : p(prime), root(generator) {
+        limb_t inv = p;
+        for (int i = 0; i < 5; ++i) inv *= 2 - p * inv;
+        p_inv_neg = 0 - inv;
+        dlimb_t r = (static_cast<dlimb_t>(1) << 32) % p;
+        r2 = static_cast<limb_t>(r * r % p);
+    }
+
+    limb_t mont_mul(limb_t a, limb_t b) const {
+        dlimb_t t = static_cast<dlimb_t>(a) * b;
+        limb_t m = static_cast<limb_t>(t) * p_inv_neg;
+        limb_t u = static_cast<limb_t>((t + static_cast<dlimb_t>(m) * p) >> 32);
+        return u >= p ? u - p : u;
+    }
+
+    limb_t to_mont(limb_t a) const { return mont_mul(a % p, r2); }
+
+    limb_t add(limb_t a, limb_t b) const {
+        limb_t s = a + b;
+        return s >= p ? s - p : s;
+    }
+
+    limb_t sub(limb_t a, limb_t b) const { return a >= b ? a - b : a + p - b; }
+
+    limb_t pow(limb_t base, dlimb_t e) const {
+        dlimb_t result = 1, b = base % p;
+        for (; e != 0; e >>= 1) {
+            if (e & 1) result = result * b % p;
+            b = b * b % p;
+        }
+        return static_cast<limb_t>(result);
+    }
+};
+
+const Modulus MODULI[3] = {
+    Modulus(469762049, 3),   // 7 * 2^26 + 1
+    Modulus(1811939329, 13), // 27 * 2^26 + 1
+    Modulus(2013265921, 31), // 15 * 2^27 + 1
+};
+
+/**
+ * @brief Таблица корней для всех уровней преобразования длины n
+ *
+ * Корни уровня с половиной блока len лежат в roots[len .. 2 * len),
+ * roots[len + j] = w_{2len}^j в форме Монтгомери.
+ */
+LimbBuffer make_roots(const Modulus &m, size_t n, bool inverse) {
+    LimbBuffer roots(std::max<size_t>(n, 2));
+    for (size_t len = 1; len < n; len <<= 1) {
+        limb_t w = m.pow(m.root, (m.p - 1) / (2 * len));
+        if (inverse) w = m.pow(w, m.p - 2);
+        limb_t w_mont = m.to_mont(w);
+        limb_t cur = m.to_mont(1);
+        for (size_t j = 0; j < len; ++j) {
+            roots[len + j] = cur;
+            cur = m.mont_mul(cur, w_mont);
+        }
+    }
+    return roots;
+}
+
+// Прямое преобразование (прореживание по частоте): естественный порядок -> бит-реверсный
+void forward(LimbBuffer &a, const LimbBuffer &roots, const Modulus &m) {
+    size_t n = a.size();
+    for (size_t len = n / 2; len >= 1; len >>= 1) {
+        const limb_t *w = roots.data() + len;
+        for (size_t s = 0; s < n; s += 2 * len) {
+            limb_t *x = a.data() + s;
+            limb_t *y = x + len;
+            for (size_t j = 0; j < len; ++j) {
+                limb_t u = x[j], v = y[j];
+                x[j] = m.add(u, v);
+                y[j] = m.mont_mul(m.sub(u, v), w[j]);
+            }
+        }
+    }
+}
+
+// Обратное преобразование (прореживание по времени): бит-реверсный порядок -> естественный
+void inverse(LimbBuffer &a, const LimbBuffer &roots, const Modulus &m) {
+    size_t n = a.size();
+    for (size_t len = 1; len < n; len <<= 1) {
+        const limb_t *w = roots.data() + len;
+        for (size_t s = 0; s < n; s += 2 * len) {
+            limb_t *x = a.data() + s;
+            limb_t *y = x + len;
+            for (size_t j = 0; j < len; ++j) {
+                limb_t u = x[j], v = m.mont_mul(y[j], w[j]);
+                x[j] = m.add(u, v);
+                y[j] = m.sub(u, v);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Циклическая свёртка a и b по одному модулю
+ * @return Коэффициенты свёртки по модулю m (первые an + bn - 1 значений)
+ *
+ * @details При b == nullptr вычисляется свёртка a с самим собой за одно прямое преобразование.
+ */
+LimbBuffer convolve(const limb_t *a, size_t an, const limb_t *b, size_t bn,
+                    size_t n, const Modulus &m) {
+    LimbBuffer fa(n);
+    for (size_t i = 0; i < an; ++i) fa[i] = a[i] % m.p;
+
+    LimbBuffer roots = make_roots(m, n, false);
+    forward(fa, roots, m);
+
+    if (b == nullptr) {
+        for (size_t i = 0; i < n; ++i) fa[i] = m.mont_mul(fa[i], fa[i]);
+    } else {
+        LimbBuffer fb(n);
+        for (size_t i = 0; i < bn; ++i) fb[i] = b[i] % m.p;
+        forward(fb, roots, m);
+        for (size_t i = 0; i < n; ++i) fa[i] = m.mont_mul(fa[i], fb[i]);
+    }
+
+    roots = make_roots(m, n, true);
+    inverse(fa, roots, m);
+
+    // Поточечное произведение дало лишний множитель R^(-1), компенсируем его вместе с 1/n
+    limb_t n_inv = m.pow(static_cast<limb_t>(n % m.p), m.p - 2);
+    limb_t scale = m.mont_mul(m.mont_mul(n_inv, m.r2), m.r2);
+    for (size_t i = 0; i < n; ++i) fa[i] = m.mont_mul(fa[i], scale);
+
+    fa.resize(an + bn - 1);
+    return fa;
+}
+
+/**
+ * @brief Общая часть mul_ntt и sqr_ntt, при b == nullptr второй операнд равен a
+ */
+void ntt_product(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    size_t conv_sz = an + bn - 1;
+    size_t n = 1;
+    while (n < conv_sz) n <<= 1;
+
+    LimbBuffer r1 = convolve(a, an, b, bn, n, MODULI[0]);
+    LimbBuffer r2 = convolve(a, an, b, bn, n, MODULI[1]);
+    LimbBuffer r3 = convolve(a, an, b, bn, n, MODULI[2]);
+
+    // Алгоритм Гарнера: x = x1 + x2 * p1 + x3 * p1 * p2
+    const dlimb_t p1 = MODULI[0].p, p2 = MODULI[1].p, p3 = MODULI[2].p;
+    const dlimb_t p1_inv_p2 = MODULI[1].pow(static_cast<limb_t>(p1 % p2), p2 - 2);
+    const dlimb_t p1_inv_p3 = MODULI[2].pow(static_cast<limb_t>(p1 % p3), p3 - 2);
+    const dlimb_t p2_inv_p3 = MODULI[2].pow(static_cast<limb_t>(p2 % p3), p3 - 2);
+    const unsigned __int128 p1p2 = static_cast<unsigned __int128>(p1) * p2;
+
+    unsigned __int128 carry = 0;
+    for (size_t i = 0; i < conv_sz; ++i) {
+        dlimb_t x1 = r1[i];
+        dlimb_t x2 = (r2[i] + p2 - x1 % p2) % p2 * p1_inv_p2 % p2;
+        dlimb_t x3 = (r3[i] + p3 - x1 % p3) % p3 * p1_inv_p3 % p3;
+        x3 = (x3 + p3 - x2 % p3) % p3 * p2_inv_p3 % p3;
+
+        carry += x1 + static_cast<unsigned __int128>(x2) * p1 + x3 * p1p2;
+        r[i] = static_cast<limb_t>(carry);
+        carry >>= 32;
+    }
+    r[conv_sz] = static_cast<limb_t>(carry);
+}
+
+} // namespace
+
+void mul_ntt(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    ntt_product(r, a, an, b, bn);
+}
+
+void sqr_ntt(limb_t *r, const limb_t *a, size_t n) {
+    ntt_product(r, a, n, nullptr, n);
+}
+
+} // namespace limbs
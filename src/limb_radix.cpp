@@ -0,0 +1,495 @@
+/**
+ * @file limb_radix.cpp
+ * @brief Перевод чисел между десятичной и двоичной (по 2^32) системами
+ *
+ * Короткие строки переводятся блоками по 9 цифр: число умножается на 10^9
+ * и к нему прибавляется очередной блок. Длинные делятся пополам по границе
+ * 9 * 2^k цифр, половины переводятся рекурсивно и собираются одним
+ * умножением на 10^(9 * 2^k), поэтому время перевода пропорционально
+ * времени умножения, а не квадрату длины.
+ *
+ * Дробь 0.d1...dn переводится одним делением: N * B^rn / 10^n, где N -
+ * целое из её цифр.
+ *
+ * Обратный перевод устроен так же: короткие числа делятся на 10^9 с
+ * заранее вычисленным обратным, длинные - на 10^(9 * 2^k) из того же
+ * кэша, частное и остаток переводятся рекурсивно. Первые m цифр дроби
+ * f / B^fn - это целое floor(f * 10^m / B^fn), переводимое тем же способом.
+ * Цифры выводятся старшими вперёд по мере перевода: в массив или блоками
+ * в DigitSink.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "../include/limb_buffer.hpp"
+#include "../include/limb_kernels.hpp"
+
+namespace limbs {
+
+namespace {
+
+/// 10^9 - наибольшая степень десяти, помещающаяся в лимб
+constexpr limb_t DEC_CHUNK_BASE = 1000000000;
+
+/**
+ * @brief Степень десяти 10^(9 * 2^k) из кэша потока
+ * @details Таблица строится возведением в квадрат и сохраняется между
+ * вызовами: при повторных переводах чисел той же длины степени не
+ * пересчитываются.
+ */
+const std::vector<limb_t> &power_of_ten(size_t k) {
+    thread_local std::vector<std::vector<limb_t>> table;
+    if (table.empty()) {
+        table.push_back({DEC_CHUNK_BASE});
+    }
+    while (table.size() <= k) {
+        const std::vector<limb_t> &prev = table.back();
+        std::vector<limb_t> next(2 * prev.size());
+        sqr(next.data(), prev.data(), prev.size());
+        next.resize(normalized_size(next.data(), next.size()));
+        table.push_back(std::move(next));
+    }
+    return table[k];
+}
+
+/**
+ * @brief Значение блока из n <= 9 десятичных цифр
+ */
+limb_t parse_chunk(const char *digits, size_t n) {
+    limb_t value = 0;
+    for (size_t i = 0; i < n; ++i) {
+        value = value * 10 + static_cast<limb_t>(digits[i] - '0');
+    }
+    return value;
+}
+
+/**
+ * @brief Перевод столбиком: r = r * 10^9 + блок для каждого блока из 9 цифр
+ * @return Длина результата без старших нулевых лимбов
+ */
+size_t set_str_basecase(limb_t *r, const char *digits, size_t n) {
+    size_t rn = 0;
+    size_t head = n % 9 == 0 ? 9 : n % 9;
+    for (size_t pos = 0; pos < n; pos += head, head = 9) {
+        dlimb_t acc = parse_chunk(digits + pos, head);
+        limb_t base = pos == 0 ? 1 : DEC_CHUNK_BASE;
+        for (size_t i = 0; i < rn; ++i) {
+            acc += static_cast<dlimb_t>(r[i]) * base;
+            r[i] = static_cast<limb_t>(acc);
+            acc >>= 32;
+        }
+        if (acc != 0) {
+            r[rn++] = static_cast<limb_t>(acc);
+        }
+    }
+    return rn;
+}
+
+/// Сколько последних степеней 10^n хранит power_of_ten_n
+constexpr size_t POWER_CACHE_SLOTS = 8;
+
+/**
+ * @brief 10^n из кэша потока
+ * @return Ссылка действительна до следующего вызова power_of_ten_n в этом потоке
+ * @details Последние POWER_CACHE_SLOTS степеней хранятся между вызовами:
+ * числа одной длины переводятся без пересчёта. Новая степень собирается
+ * из 10^(9 * 2^k) таблицы power_of_ten по двоичной записи n / 9 и
+ * домножается на 10^(n % 9) < 2^32.
+ */
+const std::vector<limb_t> &power_of_ten_n(size_t n) {
+    struct Slot {
+        size_t n = SIZE_MAX;
+        std::vector<limb_t> value;
+    };
+    thread_local Slot slots[POWER_CACHE_SLOTS];
+    thread_local size_t next_slot = 0;
+    for (Slot &slot : slots) {
+        if (slot.n == n) return slot.value;
+    }
+
+    size_t chunks = n / 9;
+    std::vector<limb_t> result = {1};
+    if (chunks != 0) {
+        // Таблица растёт до старшей степени заранее, ссылки на её элементы не меняются
+        size_t top_k = 63 - static_cast<size_t>(__builtin_clzll(chunks));
+        result = power_of_ten(top_k);
+        for (size_t k = 0; k < top_k; ++k) {
+            if ((chunks >> k & 1) == 0) continue;
+            const std::vector<limb_t> &power = power_of_ten(k);
+            std::vector<limb_t> product(result.size() + power.size());
+            mul(product.data(), result.data(), result.size(), power.data(), power.size());
+            product.resize(normalized_size(product.data(), product.size()));
+            result = std::move(product);
+        }
+    }
+    limb_t tail = 1;
+    for (size_t i = 0; i < n % 9; ++i) tail *= 10;
+    limb_t carry = mul_1(result.data(), result.data(), result.size(), tail);
+    if (carry != 0) result.push_back(carry);
+
+    Slot &slot = slots[next_slot];
+    next_slot = (next_slot + 1) % POWER_CACHE_SLOTS;
+    slot.n = n;
+    slot.value = std::move(result);
+    return slot.value;
+}
+
+/**
+ * @brief r = floor(N * B^rn / 10^n) для числа N из n цифр
+ * @param check_tail Цифры за n отброшены: проверить, что они не меняют результат
+ * @return false, если отброшенные цифры могут увеличить результат на единицу
+ *
+ * @details Отброшенный хвост добавляет к N * B^rn / 10^n меньше B^rn / 10^n,
+ * поэтому результат не меняется, если остаток деления плюс B^rn не
+ * превосходит 10^n.
+ */
+bool frac_quotient(limb_t *r, size_t rn, const char *digits, size_t n, bool check_tail) {
+    LimbBuffer u(rn + set_str_limbs(n));
+    size_t un = rn + set_str(u.data() + rn, digits, n);
+    std::fill(r, r + rn, 0);
+    if (un == rn) {
+        return true;
+    }
+
+    const std::vector<limb_t> &power = power_of_ten_n(n);
+    size_t pn = power.size();
+    LimbBuffer rem(pn + 1);
+    if (un < pn) {
+        std::copy(u.begin(), u.begin() + un, rem.begin());
+    } else {
+        // N < 10^n, поэтому частное меньше B^rn
+        LimbBuffer q(un - pn + 1);
+        divrem(q.data(), rem.data(), u.data(), un, power.data(), pn);
+        std::copy(q.begin(), q.begin() + std::min(rn, q.size()), r);
+    }
+    if (!check_tail) {
+        return true;
+    }
+
+    // 10^n > B^rn с запасом, поэтому pn > rn
+    add_1(rem.data() + rn, rem.data() + rn, pn + 1 - rn, 1);
+    return rem[pn] == 0 && cmp(rem.data(), power.data(), pn) <= 0;
+}
+
+/**
+ * @brief Приёмник цифр, пишущий в массив символов
+ */
+struct BufferOutput {
+    char *pos;        ///< Куда писать следующую цифру
+    bool skip_zeros;  ///< Ведущие нули ещё отбрасываются
+
+    void put(const char *digits, size_t n) {
+        if (skip_zeros) {
+            const char *first = std::find_if(digits, digits + n, [](char c) { return c != '0'; });
+            if (first == digits + n) return;
+            n -= static_cast<size_t>(first - digits);
+            digits = first;
+            skip_zeros = false;
+        }
+        pos = std::copy(digits, digits + n, pos);
+    }
+
+    void zeros(size_t n) {
+        if (!skip_zeros) pos = std::fill_n(pos, n, '0');
+    }
+};
+
+/**
+ * @brief Приёмник цифр, передающий их в DigitSink блоками по DIGIT_BLOCK_SIZE
+ * @details Для коротких чисел блок не длиннее самого числа
+ */
+struct SinkOutput {
+    const DigitSink &sink;   ///< Получатель блоков
+    bool skip_zeros;         ///< Ведущие нули ещё отбрасываются
+    size_t block_size;       ///< Размер блока
+    std::vector<char> block; ///< Накопленные цифры
+
+    SinkOutput(const DigitSink &s, bool skip, size_t digits)
+        : sink(s), skip_zeros(skip), block_size(std::max<size_t>(1, std::min(digits, DIGIT_BLOCK_SIZE))) {
+        block.reserve(block_size);
+    }
+
+    void put(const char *digits, size_t n) {
+        if (skip_zeros) {
+            const char *first = std::find_if(digits, digits + n, [](char c) { return c != '0'; });
+            if (first == digits + n) return;
+            n -= static_cast<size_t>(first - digits);
+            digits = first;
+            skip_zeros = false;
+        }
+        while (n > 0) {
+            size_t part = std::min(n, block_size - block.size());
+            block.insert(block.end(), digits, digits + part);
+            digits += part;
+            n -= part;
+            if (block.size() == block_size) flush();
+        }
+    }
+
+    void zeros(size_t n) {
+        if (skip_zeros) return;
+        while (n > 0) {
+            size_t part = std::min(n, block_size - block.size());
+            block.insert(block.end(), part, '0');
+            n -= part;
+            if (block.size() == block_size) flush();
+        }
+    }
+
+    void flush() {
+        if (!block.empty()) sink(block.data(), block.size());
+        block.clear();
+    }
+};
+
+/**
+ * @brief Выводит ровно digits цифр числа a < 10^digits делением на 10^9
+ * @details Каждый блок из 9 цифр - остаток деления на 10^9 с заранее
+ * вычисленным обратным. Нули слева от собственных цифр числа выводятся
+ * отдельно, поэтому буфер на стеке не зависит от digits.
+ */
+template <typename Output>
+void put_str_basecase(Output &out, size_t digits, const limb_t *a, size_t n) {
+    char buf[GET_STR_DC_THRESHOLD * 10];
+    size_t own = std::min(digits, get_str_digits(n));
+    out.zeros(digits - own);
+
+    LimbBuffer rest(a, a + n);
+    size_t rn = n;
+    const unsigned shift = __builtin_clz(DEC_CHUNK_BASE);
+    const limb_t d = DEC_CHUNK_BASE << shift;
+    const limb_t dinv = invert_limb(d);
+
+    size_t pos = own;
+    while (pos > 0) {
+        limb_t chunk = 0;
+        if (rn != 0) {
+            chunk = divmod_1_preinv(rest.data(), rest.data(), rn, d, dinv, shift);
+            rn = normalized_size(rest.data(), rn);
+        }
+        for (size_t i = 0; i < 9 && pos > 0; ++i) {
+            buf[--pos] = static_cast<char>('0' + chunk % 10);
+            chunk /= 10;
+        }
+    }
+    out.put(buf, own);
+}
+
+/**
+ * @brief Выводит ровно digits цифр числа a < 10^digits, старшие первыми
+ * @details Число делится на 10^(9 * 2^k) длиной около половины a: частное
+ * даёт старшие цифры, остаток - ровно 9 * 2^k младших. Старшая половина
+ * выводится раньше, чем переводится младшая, поэтому цифры уходят в out
+ * по мере перевода.
+ */
+template <typename Output>
+void put_str(Output &out, size_t digits, const limb_t *a, size_t n) {
+    n = normalized_size(a, n);
+    if (n < GET_STR_DC_THRESHOLD) {
+        put_str_basecase(out, digits, a, n);
+        return;
+    }
+
+    // В n лимбах не больше 9.64 * n цифр, младшая часть - не больше половины
+    size_t half = n * 964 / 200;
+    size_t k = 0;
+    while ((size_t(18) << k) <= half) {
+        k++;
+    }
+    size_t low_digits = size_t(9) << k;
+    while (low_digits >= digits) {
+        low_digits /= 2;
+        k--;
+    }
+
+    const std::vector<limb_t> &power = power_of_ten(k);
+    size_t pn = power.size();
+    size_t high_digits = digits - low_digits;
+    if (n < pn) {
+        out.zeros(high_digits);
+        put_str(out, low_digits, a, n);
+        return;
+    }
+
+    LimbBuffer q(n - pn + 1), r(pn);
+    divrem(q.data(), r.data(), a, n, power.data(), pn);
+    put_str(out, high_digits, q.data(), q.size());
+    q = LimbBuffer();
+    put_str(out, low_digits, r.data(), pn);
+}
+
+} // namespace
+
+size_t set_str_limbs(size_t n) {
+    // В лимбе log10(2^32) > 9.63 цифры, 107 / 1024 > 1 / 9.63
+    return n * 107 / 1024 + 3;
+}
+
+/**
+ * @details Младшие 9 * 2^k цифр (наибольшая такая степень, меньшая n)
+ * переводятся прямо в r, старшие - во временный массив, затем
+ * r = старшие * 10^(9 * 2^k) + младшие.
+ */
+size_t set_str(limb_t *r, const char *digits, size_t n) {
+    if (n < SET_STR_DC_THRESHOLD) {
+        return set_str_basecase(r, digits, n);
+    }
+
+    size_t k = 0;
+    while ((size_t(18) << k) < n) {
+        k++;
+    }
+    size_t low_digits = size_t(9) << k;
+    size_t high_digits = n - low_digits;
+
+    size_t ln = set_str(r, digits + high_digits, low_digits);
+    LimbBuffer high(set_str_limbs(high_digits));
+    size_t hn = set_str(high.data(), digits, high_digits);
+    if (hn == 0) {
+        return ln;
+    }
+
+    const std::vector<limb_t> &power = power_of_ten(k);
+    LimbBuffer product(power.size() + hn);
+    mul(product.data(), power.data(), power.size(), high.data(), hn);
+    size_t pn = normalized_size(product.data(), product.size());
+
+    // Произведение не меньше 10^(9 * 2^k) и длиннее младшей части
+    limb_t carry = add(r, product.data(), pn, r, ln);
+    if (carry != 0) {
+        r[pn++] = carry;
+    }
+    return pn;
+}
+
+/**
+ * @details Для rn лимбов достаточно 9.64 * rn цифр: берутся они и ещё
+ * FRAC_GUARD_DIGITS запасных. Если отброшенные цифры всё же могут изменить
+ * результат (вероятность порядка 10^-FRAC_GUARD_DIGITS), дробь переводится
+ * целиком.
+ */
+void set_frac_str(limb_t *r, size_t rn, const char *digits, size_t n) {
+    size_t keep = std::min(n, rn * 964 / 100 + 1 + FRAC_GUARD_DIGITS);
+    bool tail_nonzero = std::any_of(digits + keep, digits + n, [](char c) { return c != '0'; });
+    if (!frac_quotient(r, rn, digits, keep, tail_nonzero)) {
+        frac_quotient(r, rn, digits, n, false);
+    }
+}
+
+size_t get_str_digits(size_t n) {
+    return n * 964 / 100 + 1;
+}
+
+size_t get_str(char *out, const limb_t *a, size_t n) {
+    n = normalized_size(a, n);
+    BufferOutput output{out, true};
+    put_str(output, get_str_digits(n), a, n);
+    return static_cast<size_t>(output.pos - out);
+}
+
+void write_str(const DigitSink &sink, const limb_t *a, size_t n) {
+    n = normalized_size(a, n);
+    SinkOutput output(sink, true, get_str_digits(n));
+    put_str(output, get_str_digits(n), a, n);
+    output.flush();
+}
+
+/**
+ * @details Числа до 64 бит сравниваются со степенями десяти в машинных
+ * словах. Для длинных: число из b бит лежит в [2^(b-1), 2^b), поэтому
+ * цифр у него floor((b - 1) * log10(2)) + 1 или на одну больше. log10(2)
+ * берётся с недостатком и с избытком в виде дроби x / 2^32; если оценки
+ * расходятся, число сравнивается со степенью десяти из кэша
+ * power_of_ten_n - для чисел одной длины она не пересчитывается.
+ */
+size_t decimal_digits(const limb_t *a, size_t n) {
+    n = normalized_size(a, n);
+    if (n == 0) {
+        return 0;
+    }
+    if (n <= 2) {
+        dlimb_t value = n == 2 ? (static_cast<dlimb_t>(a[1]) << 32) | a[0] : a[0];
+        size_t digits = 1;
+        for (dlimb_t power = 10; digits < 20 && value >= power; power *= 10) {
+            digits++;
+        }
+        return digits;
+    }
+
+    dlimb_t bits = 32 * static_cast<dlimb_t>(n) - static_cast<dlimb_t>(__builtin_clz(a[n - 1]));
+    // 1292913986 / 2^32 < log10(2) < 1292913987 / 2^32
+    size_t digits = static_cast<size_t>(((bits - 1) * 1292913986) >> 32) + 1;
+    size_t most = static_cast<size_t>((bits * 1292913987) >> 32) + 1;
+    while (digits < most) {
+        const std::vector<limb_t> &power = power_of_ten_n(digits);
+        if (power.size() > n || (power.size() == n && cmp(a, power.data(), n) < 0)) {
+            break;
+        }
+        digits++;
+    }
+    return digits;
+}
+
+void get_str_padded(char *out, size_t digits, const limb_t *a, size_t n) {
+    BufferOutput output{out, false};
+    put_str(output, digits, a, n);
+}
+
+void write_str_padded(const DigitSink &sink, size_t digits, const limb_t *a, size_t n) {
+    SinkOutput output(sink, false, digits);
+    put_str(output, digits, a, n);
+    output.flush();
+}
+
+size_t frac_digits_limbs(size_t m) {
+    return set_str_limbs(m + 1);
+}
+
+/**
+ * @details Для m цифр достаточно старших лимбов f длиной 10^m и ещё двух:
+ * отброшенные младшие лимбы добавляют к произведению меньше 10^m, и если
+ * сумма остатка и 10^m не переходит через B^t, частное от них не зависит.
+ * Иначе произведение берётся целиком. Округление - прибавление B^t / 2
+ * к произведению перед отбрасыванием младших t лимбов.
+ */
+bool frac_digits(limb_t *r, size_t m, const limb_t *f, size_t fn, bool round) {
+    const std::vector<limb_t> &power = power_of_ten_n(m);
+    size_t pn = power.size();
+
+    size_t t = std::min(fn, pn + 2);
+    bool low_nonzero = normalized_size(f, fn - t) != 0;
+    LimbBuffer product(t + pn + 1);
+    mul(product.data(), f + (fn - t), t, power.data(), pn);
+    if (round) {
+        add_1(product.data() + t - 1, product.data() + t - 1, pn + 2, 0x80000000);
+    }
+
+    if (low_nonzero) {
+        LimbBuffer sum(t);
+        limb_t carry = add(sum.data(), product.data(), t, power.data(), pn);
+        if (carry != 0 && normalized_size(sum.data(), t) != 0) {
+            t = fn;
+            product.clear();
+            product.resize(t + pn + 1);
+            mul(product.data(), f, fn, power.data(), pn);
+            if (round) {
+                add_1(product.data() + t - 1, product.data() + t - 1, pn + 2, 0x80000000);
+            }
+        }
+    }
+
+    std::fill(r, r + frac_digits_limbs(m), 0);
+    std::copy(product.begin() + t, product.end(), r);
+
+    // Округление могло дать ровно 10^m
+    if (round && product[t + pn] == 0 && cmp(r, power.data(), pn) == 0) {
+        std::fill(r, r + pn, 0);
+        return true;
+    }
+    return false;
+}
+
+} // namespace limbs
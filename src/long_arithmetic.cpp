@@ -5,11 +5,18 @@
 
 #include <iostream>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <stdexcept>
+#include <utility>
 
 #include <chrono>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
 
 #include "../include/long_arithmetic.hpp"
+#include "../include/limb_kernels.hpp"
 
 /**
  * @brief Конструктор из строки с указанием бит дробной части
@@ -19,221 +26,302 @@
 FixedPoint::FixedPoint(const std::string &num_str, int frac_bits) : fractional_bits(frac_bits) {
     auto binary_result = decimal_to_binary(num_str, fractional_bits);
 
-    integer = binary_result.first;     // Сохранение целой части в двоичном формате
-    fractional = binary_result.second; // Сохранение дробной части в двоичном формате
+    // Целая и дробная части в двоичном формате
+    assign_parts(binary_result.first, binary_result.second);
     is_negative = num_str[0] == '-';
 }
 
+namespace {
+
+/**
+ * @class CharsScratch
+ * @brief Временная память для from_chars и to_chars
+ * @details Пока объект жив, буферы лимбов берутся из массива
+ * CHARS_SCRATCH_BYTES байт на стеке, а когда его не хватает - из ресурса,
+ * действовавшего до создания объекта. Арена не освобождает память до
+ * конца области, поэтому подключается только для чисел, временные лимбы
+ * которых заведомо невелики; длинные числа работают с обычным ресурсом.
+ * Числа, созданные в области, не должны её переживать.
+ */
+class CharsScratch {
+public:
+    /**
+     * @param limbs Длина преобразуемого числа в лимбах
+     */
+    explicit CharsScratch(size_t limbs) {
+        if (limbs * MAX_SCRATCH_PER_LIMB <= CHARS_SCRATCH_BYTES) {
+            arena.emplace(storage, sizeof(storage), limb_resource());
+            scope.emplace(&*arena);
+        }
+    }
+
+private:
+    /// Оценка временной памяти на лимб числа: несколько копий по 4 байта
+    static constexpr size_t MAX_SCRATCH_PER_LIMB = 64;
+
+    alignas(std::max_align_t) std::byte storage[CHARS_SCRATCH_BYTES]; ///< Память на стеке
+    std::optional<std::pmr::monotonic_buffer_resource> arena;          ///< Выделение из storage
+    std::optional<LimbResourceScope> scope;                            ///< Подключение arena к буферам лимбов
+};
+
+/**
+ * @brief Раскладывает конечное число с плавающей точкой на мантиссу и степень двойки
+ * @param num Число
+ * @param mag Лимбы модуля мантиссы, младший первым
+ * @param exp Показатель: |num| = mag * 2^exp
+ * @return Количество лимбов мантиссы
+ * @throw std::invalid_argument для NaN и бесконечности
+ * @details Мантисса снимается по 32 бита через frexp/ldexp, что точно
+ * для любого двоичного формата - и double, и 80- или 128-битного long double.
+ */
+template <typename Float, size_t N>
+size_t decompose_float(Float num, uint32_t (&mag)[N], long long &exp) {
+    static_assert(N * 32 >= std::numeric_limits<Float>::digits + 32, "mantissa buffer too short");
+    if (!std::isfinite(num)) {
+        throw std::invalid_argument("FixedPoint cannot represent NaN or infinity");
+    }
+
+    int frac_exp = 0;
+    Float frac = std::frexp(std::fabs(num), &frac_exp);
+    uint32_t high_first[N] = {};
+    size_t n = 0;
+    while (frac != 0) {
+        frac = std::ldexp(frac, 32);
+        uint32_t chunk = static_cast<uint32_t>(frac);
+        frac -= chunk;
+        high_first[n++] = chunk;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        mag[i] = high_first[n - 1 - i];
+    }
+    exp = static_cast<long long>(frac_exp) - 32 * static_cast<long long>(n);
+    return n;
+}
+
+} // namespace
+
 /**
  * @brief Конструктор из числа double с указанием бит дробной части
  * @param num Число для инициализации
  * @param frac_bits Количество бит дробной части
+ * @details Мантисса и порядок double записываются в лимбы напрямую: значение
+ * точное, дробная часть лишь усекается до frac_bits бит
  */
 FixedPoint::FixedPoint(const double &num, int frac_bits) : fractional_bits(frac_bits) {
-    auto binary_result = decimal_to_binary(std::to_string(num), fractional_bits);
-
-    integer = binary_result.first;     
-    fractional = binary_result.second;
+    uint32_t mag[3];
+    long long exp = 0;
+    size_t n = decompose_float(num, mag, exp);
+    assign_scaled(mag, n, exp, frac_bits);
     is_negative = num < 0;
 }
 
+FixedPoint::FixedPoint(long double num, int frac_bits) : fractional_bits(frac_bits) {
+    uint32_t mag[(std::numeric_limits<long double>::digits + 31) / 32 + 1];
+    long long exp = 0;
+    size_t n = decompose_float(num, mag, exp);
+    assign_scaled(mag, n, exp, frac_bits);
+    is_negative = num < 0;
+}
 
-// Конструктор и деструктор копирования 
-FixedPoint::FixedPoint(const FixedPoint& other) = default;
-FixedPoint::~FixedPoint() = default;
+#ifdef __SIZEOF_INT128__
+FixedPoint::FixedPoint(__int128 value, int frac_bits) : fractional_bits(frac_bits) {
+    unsigned __int128 abs_value = value < 0 ? 0 - static_cast<unsigned __int128>(value)
+                                            : static_cast<unsigned __int128>(value);
+    uint32_t mag[4];
+    for (size_t i = 0; i < 4; ++i) {
+        mag[i] = static_cast<uint32_t>(abs_value >> (32 * i));
+    }
+    assign_scaled(mag, 4, 0, frac_bits);
+    is_negative = value < 0;
+}
 
-// Оператор присваивания 
-FixedPoint& FixedPoint::operator=(const FixedPoint& other) = default;
+FixedPoint::FixedPoint(unsigned __int128 value, int frac_bits) : fractional_bits(frac_bits) {
+    uint32_t mag[4];
+    for (size_t i = 0; i < 4; ++i) {
+        mag[i] = static_cast<uint32_t>(value >> (32 * i));
+    }
+    assign_scaled(mag, 4, 0, frac_bits);
+    is_negative = false;
+}
+#endif
 
 /**
- * @brief Оператор сложения
- * @param other Слагаемое
- * @return Результат сложения
- * @details Реализует сложение с учетом знаков чисел и переносов
+ * @details Старший значащий бит выравнивается к 63-му биту uint64_t, а всё,
+ * что ниже 64 взятых бит, сворачивается в младший бит (sticky). Он лежит
+ * ниже позиции округления double, поэтому единственное округление при
+ * преобразовании uint64_t в double получается корректным.
  */
-FixedPoint FixedPoint::operator+(const FixedPoint &other) const {
-
-    Op_behavior behavior = helper(*this, other, '+');
-
-    
-    FixedPoint result("0.0", std::max(fractional_bits, other.fractional_bits));
+double FixedPoint::to_double() const {
+    if (top == 0) {
+        return is_negative ? -0.0 : 0.0;
+    }
 
-    switch (behavior) {
-        case Op_behavior::PLUS_FST: {
-            bool res_compare = !less_abs(*this, other);
-            const FixedPoint &a = (res_compare ? *this : other);
-            const FixedPoint &b = (res_compare ? other : *this);
+    const uint32_t *limbs = limb_data();
+    auto limb = [&](long long i) -> uint64_t { return i >= 0 ? limbs[i] : 0; };
+    long long hi = static_cast<long long>(top) - 1;
+    unsigned lz = __builtin_clz(limbs[hi]);
 
-            auto sub_res = subtract_nums(a, b);
+    uint64_t bits = (limb(hi) << (32 + lz)) | (limb(hi - 1) << lz);
+    bool sticky = false;
+    if (lz != 0) {
+        bits |= limb(hi - 2) >> (32 - lz);
+        sticky = static_cast<uint32_t>(limb(hi - 2) << lz) != 0;
+    } else {
+        sticky = limb(hi - 2) != 0;
+    }
+    for (long long i = hi - 3; i >= 0 && !sticky; --i) {
+        sticky = limbs[i] != 0;
+    }
+    bits |= sticky ? 1 : 0;
 
-            result.integer = sub_res.first;     
-            result.fractional = sub_res.second; 
-            result.is_negative = a.is_negative;
-            break;
-        }
-        case Op_behavior::PLUS_SND: {
+    // Младший бит bits стоит на позиции 32 * hi + 31 - lz - 63 от начала лимбов
+    long long exp = 32 * hi - static_cast<long long>(lz) - 32 - 32 * static_cast<long long>(frac_limbs);
+    double result = std::ldexp(static_cast<double>(bits), static_cast<int>(exp));
+    return is_negative ? -result : result;
+}
 
-            
-            auto add_res = add_frac(fractional, other.fractional);
-            result.fractional = add_res.first;
 
-            
-            add_res = add_int(integer, other.integer, add_res.second);
-            result.integer = add_res.first;
+// Конструктор и деструктор копирования: копируются только лимбы числа, без запаса буфера
+FixedPoint::FixedPoint(const FixedPoint& other)
+    : limb_buffer(other.limb_data(), other.limb_data() + other.length),
+      frac_limbs(other.frac_limbs),
+      length(other.length),
+      top(other.top),
+      fractional_bits(other.fractional_bits),
+      is_negative(other.is_negative) {}
+FixedPoint::~FixedPoint() = default;
 
-            
-            if (add_res.second) {
-                result.integer.push_back(1);
-            }
-            result.is_negative = is_negative;
-            break;
-        }
-        default:
-            throw std::invalid_argument("Unexpected behavior encountered");
+// Оператор присваивания: буфер *this переиспользуется, если его хватает
+FixedPoint& FixedPoint::operator=(const FixedPoint& other) {
+    if (this != &other) {
+        limb_buffer.assign(other.limb_data(), other.limb_data() + other.length);
+        offset = 0;
+        frac_limbs = other.frac_limbs;
+        length = other.length;
+        top = other.top;
+        fractional_bits = other.fractional_bits;
+        is_negative = other.is_negative;
     }
+    return *this;
+}
 
-    while (result.fractional.size() > 1 && result.fractional.front() == 0) {
-        result.fractional.erase(result.fractional.begin());
-    }
-    while (result.integer.size() > 1 && result.integer.back() == 0) {
-        result.integer.erase(result.integer.end() - 1);
-    }
-    result.fractional_bits = result.fractional.size() * 32;
+// Конструктор и оператор перемещения: лимбы забираются у other
+FixedPoint::FixedPoint(FixedPoint&& other) noexcept = default;
+FixedPoint& FixedPoint::operator=(FixedPoint&& other) noexcept = default;
 
+/**
+ * @brief Оператор сложения
+ * @param other Слагаемое
+ * @return Результат сложения
+ * @details Копия *this, к которой other прибавляется на месте (см. operator+=)
+ */
+FixedPoint FixedPoint::operator+(const FixedPoint &other) const & {
+    FixedPoint result(*this);
+    result += other;
     return result;
 }
 
+FixedPoint FixedPoint::operator+(const FixedPoint &other) && {
+    *this += other;
+    return std::move(*this);
+}
 
 /**
- * @brief Оператор вычитания
- * @param other Вычитаемое
- * @return Результат вычитания
- * @details Реализует вычитание с учетом знаков чисел и заемов
+ * @details Сумма записывается в лимбы временного other. Нулевая сумма
+ * получает знак *this, как в operator+=.
  */
-FixedPoint FixedPoint::operator-(const FixedPoint &other) const {
+FixedPoint FixedPoint::operator+(FixedPoint &&other) const & {
+    other += *this;
+    if (other.is_zero()) other.is_negative = is_negative;
+    return std::move(other);
+}
 
-    Op_behavior behavior = helper(*this, other, '-');
-    
-    FixedPoint result("0.0", std::max(fractional_bits, other.fractional_bits));
-
-    switch (behavior) {
-        case Op_behavior::SUB_FST: {
-            
-            auto add_res = add_frac(fractional, other.fractional);
-            result.fractional = add_res.first;
-
-            
-            add_res = add_int(integer, other.integer, add_res.second);
-            result.integer = add_res.first;
-
-            
-            if (add_res.second) {
-                result.integer.push_back(1);
-            }
-            result.is_negative = is_negative;
-            break;
-        }
-        case Op_behavior::SUB_SND: {
-            bool res_compare = !less_abs(*this, other);
-            const FixedPoint &a = (res_compare ? *this : other);
-            const FixedPoint &b = (res_compare ? other : *this);
+FixedPoint FixedPoint::operator+(FixedPoint &&other) && {
+    *this += other;
+    return std::move(*this);
+}
 
-            auto sub_res = subtract_nums(a, b);
 
-            result.integer = sub_res.first;     
-            result.fractional = sub_res.second;
-            result.is_negative = (is_negative ? res_compare : !res_compare);
+/**
+ * @brief Оператор вычитания
+ * @param other Вычитаемое
+ * @return Результат вычитания
+ * @details Копия *this, из которой other вычитается на месте (см. operator-=)
+ */
+FixedPoint FixedPoint::operator-(const FixedPoint &other) const & {
+    FixedPoint result(*this);
+    result -= other;
+    return result;
+}
 
-            break;
-        }
-        default:
-            throw std::invalid_argument("Unexpected behavior encountered");
-    }
+FixedPoint FixedPoint::operator-(const FixedPoint &other) && {
+    *this -= other;
+    return std::move(*this);
+}
 
-    while (result.fractional.size() > 1 && result.fractional.front() == 0) {
-        result.fractional.erase(result.fractional.begin());
-    }
-    while (result.integer.size() > 1 && result.integer.back() == 0) {
-        result.integer.erase(result.integer.end() - 1);
-    }
-    result.fractional_bits = result.fractional.size() * 32;
+/**
+ * @details В лимбах временного other считается other - *this, затем знак
+ * меняется. Нулевая разность получает знак *this, как в operator-=.
+ */
+FixedPoint FixedPoint::operator-(FixedPoint &&other) const & {
+    other -= *this;
+    other.is_negative = other.is_zero() ? is_negative : !other.is_negative;
+    return std::move(other);
+}
 
-    return result;
+FixedPoint FixedPoint::operator-(FixedPoint &&other) && {
+    *this -= other;
+    return std::move(*this);
 }
 
 /**
  * @brief Оператор умножения
  * @param other Множитель
  * @return Результат умножения
- * @details Реализует побитовое умножение с учетом переносов
+ * @details Лимбы каждого множителя (дробная и целая части подряд, младший
+ * первым) перемножаются как целые числа через limbs::mul. Младшие
+ * frac_limbs + other.frac_limbs лимбов произведения образуют дробную часть
+ * результата. Умножение числа на само
+ * себя (a * a) передаётся в square().
  */
-FixedPoint FixedPoint::operator*(const FixedPoint &other) const {
-    
-    FixedPoint result("0.0", (fractional_bits / 32 + 1) * 32 + (other.fractional_bits / 32 +  1) * 32);
+FixedPoint FixedPoint::operator*(const FixedPoint &other) const & {
+    if (&other == this) {
+        return square();
+    }
 
-    
-    uint32_t this_sz = integer.size() + fractional.size();
-    uint32_t other_sz = other.integer.size() + other.fractional.size();
+    FixedPoint result(*this);
+    result *= other;
+    return result;
+}
 
-    
-    uint32_t mid_mult_sz = (this_sz + other_sz) * 32 + 1;
-    std::vector<uint32_t> mid_mult(mid_mult_sz);
+FixedPoint FixedPoint::operator*(const FixedPoint &other) && {
+    *this *= other;
+    return std::move(*this);
+}
 
-    
-    for (uint32_t this_i = 0; this_i < this_sz; this_i++) {
-        for (uint32_t bit_this = 0; bit_this < 32; bit_this++) {
-            for (uint32_t other_i = 0; other_i < other_sz; other_i++) {
-                for (uint32_t bit_other = 0; bit_other < 32; bit_other++) {
-                    if (this_i < fractional.size() && other_i < other.fractional.size()) {
-                        mid_mult[32 * (this_i + other_i) + bit_this + bit_other] +=
-                        (fractional[this_i] >> bit_this) & (other.fractional[other_i] >> bit_other) & 0x00000001;
-                    }
-                    if (this_i < fractional.size() && other_i >= other.fractional.size()) {
-                        mid_mult[32 * (this_i + other_i) + bit_this + bit_other] +=
-                        (fractional[this_i] >> bit_this) & (other.integer[other_i - other.fractional.size()] >> bit_other) & 0x00000001;
-                    }
-                    if (this_i >= fractional.size() && other_i < other.fractional.size()) {
-                        mid_mult[32 * (this_i + other_i) + bit_this + bit_other] +=
-                        (integer[this_i - fractional.size()] >> bit_this) & (other.fractional[other_i] >> bit_other) & 0x00000001;
-                    }
-                    if (this_i >= fractional.size() && other_i >= other.fractional.size()) {
-                        mid_mult[32 * (this_i + other_i) + bit_this + bit_other] +=
-                        (integer[this_i - fractional.size()] >> bit_this) & (other.integer[other_i - other.fractional.size()] >> bit_other) & 0x00000001;
-                    }
-                }
-            }
-        }
-    }
+FixedPoint FixedPoint::operator*(FixedPoint &&other) const & {
+    other *= *this;
+    return std::move(other);
+}
 
-    std::vector<uint32_t> mult_int_result;
-    std::vector<uint32_t> mult_frac_result;
-    int bit_added = 0;
+FixedPoint FixedPoint::operator*(FixedPoint &&other) && {
+    *this *= other;
+    return std::move(*this);
+}
 
-    for (size_t i = 0; i < mid_mult_sz - 1; i++) {
-        if (i < 32 * (fractional.size() + other.fractional.size())) {
-            if (bit_added == 0) mult_frac_result.push_back(0);
-            mult_frac_result.back() = mult_frac_result.back() | ((mid_mult[i] % 2) << bit_added);
-            mid_mult[i + 1] += mid_mult[i] / 2;
-            bit_added = (bit_added + 1) % 32;
-        } else {
-            if (bit_added == 0) mult_int_result.push_back(0);
-            mult_int_result.back() = mult_int_result.back() | ((mid_mult[i] % 2) << bit_added);
-            mid_mult[i + 1] += mid_mult[i] / 2;
-            bit_added = (bit_added + 1) % 32;
-        }
-    }
+/**
+ * @brief Квадрат числа
+ * @return Квадрат с дробной частью из 2 * frac_limbs лимбов до нормализации
+ * @details Лимбы числа возводятся в квадрат через limbs::sqr
+ */
+FixedPoint FixedPoint::square() const {
+    FixedPoint result;
 
-    result.integer = mult_int_result;     
-    result.fractional = mult_frac_result; 
-    result.is_negative = is_negative ^ other.is_negative;
+    LimbBuffer product(2 * length);
+    limbs::sqr(product.data(), limb_data(), length);
 
-    while (result.fractional.size() > 1 && result.fractional.front() == 0) {
-        result.fractional.erase(result.fractional.begin());
-    }
-    while (result.integer.size() > 1 && result.integer.back() == 0) {
-        result.integer.erase(result.integer.end() - 1);
-    }
-    result.fractional_bits = result.fractional.size() * 32;
+    result.assign_limbs(std::move(product), 2 * frac_limbs);
+    result.is_negative = false;
 
     return result;
 }
@@ -243,116 +331,318 @@ FixedPoint FixedPoint::operator*(const FixedPoint &other) const {
  * @param other Делитель
  * @return Результат деления
  * @throw std::runtime_error при делении на ноль
- * @details Реализует алгоритм деления с восстановлением остатка
+ * @details Делит склеенные лимбы чисел столбиком по лимбам (см. divide)
  */
-FixedPoint FixedPoint::operator/(const FixedPoint &other) const {
-    
-    FixedPoint result("0.0", std::max(fractional_bits, other.fractional_bits));
+FixedPoint FixedPoint::operator/(const FixedPoint &other) const & {
+    FixedPoint result(*this);
+    result /= other;
+    return result;
+}
 
-    auto div_res = divide(*this, other);
+FixedPoint FixedPoint::operator/(const FixedPoint &other) && {
+    *this /= other;
+    return std::move(*this);
+}
 
-    result.integer.clear();
-    result.fractional.clear();
+/**
+ * @brief Обратное число
+ * @param precision Количество бит дробной части результата
+ * @return floor(2^precision / |x|) / 2^precision со знаком числа
+ * @throw std::runtime_error если число равно нулю
+ * @details Лимбы числа X сдвигаются до нормализованного делителя
+ * длины n и дополняются нулями снизу так, чтобы floor(B^(2n) / X') содержал
+ * все нужные лимбы результата. Лишние младшие биты отбрасываются сдвигом,
+ * что не меняет усечения: floor(floor(y) / 2^t) = floor(y / 2^t).
+ */
+FixedPoint FixedPoint::reciprocal(size_t precision) const {
+    const uint32_t *x = limb_data();
+    size_t xn = limbs::normalized_size(x, length);
+    if (xn == 0) {
+        throw std::runtime_error("Attempted division by zero");
+    }
 
-    result.integer = div_res.first;
-    result.fractional = div_res.second;
+    // Нужно floor(B^target / X), target = дробные лимбы результата + дробные лимбы числа
+    size_t frac_sz = (precision + 31) / 32;
+    size_t target = frac_sz + frac_limbs;
+    size_t n = std::max(xn, target + 1 > xn ? target + 1 - xn : size_t(1));
+    unsigned shift = __builtin_clz(x[xn - 1]);
 
-    if (result.integer.empty()) result.integer.push_back(0);
-    if (result.fractional.empty()) result.fractional.push_back(0);
+    LimbBuffer v(n);
+    std::copy(x, x + xn, v.begin() + (n - xn));
+    if (shift != 0) {
+        limbs::lshift(v.data() + (n - xn), v.data() + (n - xn), xn, shift);
+    }
 
-    result.is_negative = is_negative ^ other.is_negative;
+    LimbBuffer inv(n + 1);
+    limbs::invert(inv.data(), v.data(), n);
 
-    while (result.fractional.size() > 1 && result.fractional.front() == 0) {
-        result.fractional.erase(result.fractional.begin());
+    // inv = floor(B^(n + xn) / (X * 2^shift)), сдвигаем на (n + xn - target) лимбов и на -shift бит
+    size_t drop_bits = 32 * (n + xn - target) - shift;
+    size_t drop_limbs = drop_bits / 32;
+    // Отброшенные лимбы остаются под окном результата
+    size_t inv_sz = inv.size() - drop_limbs;
+    if (drop_bits % 32 != 0) {
+        limbs::rshift(inv.data() + drop_limbs, inv.data() + drop_limbs, inv_sz, drop_bits % 32);
     }
-    while (result.integer.size() > 1 && result.integer.back() == 0) {
-        result.integer.erase(result.integer.end() - 1);
+    if (inv_sz < frac_sz + 1) {
+        inv.resize(drop_limbs + frac_sz + 1);
+        inv_sz = frac_sz + 1;
     }
 
-    result.fractional_bits = result.fractional.size() * 32;
+    FixedPoint result;
+    uint32_t *r = inv.data() + drop_limbs;
+    size_t int_end = std::max(frac_sz + 1, frac_sz + limbs::normalized_size(r + frac_sz, inv_sz - frac_sz));
+    if (precision % 32 != 0) {
+        r[0] &= 0xFFFFFFFF << (32 - precision % 32);
+    }
+    result.limb_buffer = std::move(inv);
+    result.offset = drop_limbs;
+    result.frac_limbs = frac_sz;
+    result.length = int_end;
+    result.update_top();
+    result.fractional_bits = precision;
+    result.is_negative = is_negative;
 
     return result;
 }
 
+/**
+ * @brief Сложение с целым числом со знаком
+ * @param value Модуль слагаемого
+ * @param negative Знак слагаемого
+ * @return Сумма; при равных модулях знак берётся от *this, как в operator+
+ * @details Слагаемое прибавляется или вычитается из склеенных лимбов
+ * начиная с первого лимба целой части. Если модуль value больше модуля
+ * числа, склеенные лимбы сначала заменяются дополнением до 2^(32n).
+ */
+FixedPoint FixedPoint::add_scalar(uint64_t value, bool negative) const {
+    FixedPoint result;
+
+    size_t frac_sz = frac_limbs;
+    LimbBuffer sum = joined_limbs(int_size() < 2 ? 3 - int_size() : 1);
+    uint32_t *int_limbs = sum.data() + frac_sz;
+    size_t int_sz = sum.size() - frac_sz;
+    const uint32_t addend[2] = {static_cast<uint32_t>(value), static_cast<uint32_t>(value >> 32)};
+
+    if (negative == is_negative) {
+        limbs::add(int_limbs, int_limbs, int_sz, addend, 2);
+        result.is_negative = is_negative;
+    } else {
+        size_t int_norm = limbs::normalized_size(int_data(), int_size());
+        uint64_t int_value = 0;
+        for (size_t i = std::min<size_t>(int_norm, 2); i-- > 0;) {
+            int_value = (int_value << 32) | int_data()[i];
+        }
 
-bool FixedPoint::operator>(const FixedPoint &other) const {
-    bool abs_compare = bigger_abs(*this, other);
-    if (!is_negative && !other.is_negative) return abs_compare;
-    if (is_negative && other.is_negative) return !abs_compare;
-    return !is_negative;
+        if (int_norm > 2 || int_value >= value) {
+            limbs::sub(int_limbs, int_limbs, int_sz, addend, 2);
+            result.is_negative = is_negative;
+        } else {
+            for (uint32_t &limb : sum) limb = ~limb;
+            limbs::add_1(sum.data(), sum.data(), sum.size(), 1);
+            limbs::add(int_limbs, int_limbs, int_sz, addend, 2);
+            result.is_negative = negative;
+        }
+    }
+
+    result.assign_limbs(std::move(sum), frac_sz);
+    return result;
 }
 
-bool FixedPoint::operator<(const FixedPoint &other) const {
-    bool abs_compare = less_abs(*this, other);
-    if (!is_negative && !other.is_negative) return abs_compare;
-    if (is_negative && other.is_negative) return !abs_compare;
-    return is_negative;
+/**
+ * @brief Умножение на целое число со знаком
+ * @param value Модуль множителя
+ * @param negative Знак множителя
+ * @return Произведение
+ * @details Множитель из одного лимба обрабатывается за один проход
+ * limbs::mul_1, из двух лимбов - через limbs::mul.
+ */
+FixedPoint FixedPoint::mul_scalar(uint64_t value, bool negative) const {
+    FixedPoint result;
+
+    size_t n = length;
+    LimbBuffer product(n + 2);
+
+    if ((value >> 32) == 0) {
+        product[n] = limbs::mul_1(product.data(), limb_data(), n, static_cast<uint32_t>(value));
+    } else {
+        const uint32_t factor[2] = {static_cast<uint32_t>(value), static_cast<uint32_t>(value >> 32)};
+        limbs::mul(product.data(), limb_data(), n, factor, 2);
+    }
+
+    result.assign_limbs(std::move(product), frac_limbs);
+    result.is_negative = is_negative ^ negative;
+    return result;
 }
 
-bool FixedPoint::operator==(const FixedPoint &other) const {
-    for (int i = std::max(integer.size(), other.integer.size()) - 1; i >= 0; i--) {
-        uint32_t val_a = ((uint32_t) i) < integer.size() ? integer[i] : 0;
-        uint32_t val_b = ((uint32_t) i) < other.integer.size() ? other.integer[i] : 0;
-        if (val_a != val_b) {
-            return false;
-        }
+/**
+ * @brief Деление на целое число со знаком
+ * @param value Модуль делителя
+ * @param negative Знак делителя
+ * @return Частное, усечённое до frac_limbs лимбов дробной части
+ * @throw std::runtime_error при делении на ноль
+ */
+FixedPoint FixedPoint::div_scalar(uint64_t value, bool negative) const {
+    if (value == 0) {
+        throw std::runtime_error("Division by zero");
     }
 
-    int this_i = fractional.size() - 1, other_i = other.fractional.size() - 1;
-    for (; this_i >= 0 && other_i >= 0; this_i--, other_i--) {
+    FixedPoint result;
 
-        if (fractional[this_i] != other.fractional[other_i]) {
-            return false;
-        }
+    LimbBuffer quotient = joined_limbs();
+    if ((value >> 32) == 0) {
+        limbs::divmod_1(quotient.data(), quotient.data(), quotient.size(), static_cast<uint32_t>(value));
+    } else {
+        limbs::divmod_2(quotient.data(), quotient.data(), quotient.size(), value);
     }
 
-    if (this_i == -1 && other_i == -1) return true;
-    if (this_i == -1) {
-        for (; other_i >= 0; other_i--) {
-            if (other.fractional[other_i] != 0) return false;
-        }
+    result.assign_limbs(std::move(quotient), frac_limbs);
+    if (result.frac_limbs == 0) {
+        result.extend_fraction(1);
+        result.fractional_bits = 32;
     }
-    if (other_i == -1) {
-        for (; this_i >= 0; this_i--) {
-            if (fractional[this_i] != 0) return false;
-        }
+    result.is_negative = is_negative ^ negative;
+    return result;
+}
+
+/**
+ * @brief Деление на целое число с остатком
+ * @param value Модуль делителя
+ * @param negative Знак делителя
+ * @return Пара: целое частное и остаток со знаком делимого
+ * @throw std::runtime_error при делении на ноль
+ * @details Делится только целая часть: дробная часть числа целиком
+ * переходит в остаток.
+ */
+std::pair<FixedPoint, FixedPoint> FixedPoint::divmod_scalar(uint64_t value, bool negative) const {
+    if (value == 0) {
+        throw std::runtime_error("Division by zero");
+    }
+
+    LimbBuffer quotient_limbs(int_data(), int_data() + int_size());
+    uint64_t rem;
+    if ((value >> 32) == 0) {
+        rem = limbs::divmod_1(quotient_limbs.data(), quotient_limbs.data(), quotient_limbs.size(),
+                              static_cast<uint32_t>(value));
+    } else {
+        rem = limbs::divmod_2(quotient_limbs.data(), quotient_limbs.data(), quotient_limbs.size(), value);
     }
-    return false;
+
+    FixedPoint quotient;
+    quotient.assign_limbs(std::move(quotient_limbs), 0);
+    quotient.is_negative = is_negative ^ negative;
+
+    LimbBuffer remainder_limbs(limb_data(), limb_data() + frac_limbs);
+    remainder_limbs.push_back(static_cast<uint32_t>(rem));
+    remainder_limbs.push_back(static_cast<uint32_t>(rem >> 32));
+
+    FixedPoint remainder;
+    remainder.assign_limbs(std::move(remainder_limbs), frac_limbs);
+    remainder.is_negative = is_negative;
+
+    return {std::move(quotient), std::move(remainder)};
+}
+
+
+int FixedPoint::compare(const FixedPoint &other) const {
+    bool this_negative = is_negative && top != 0;
+    bool other_negative = other.is_negative && other.top != 0;
+    if (this_negative != other_negative) {
+        return this_negative ? -1 : 1;
+    }
+    int abs_compare = compare_abs(*this, other);
+    return this_negative ? -abs_compare : abs_compare;
+}
+
+bool FixedPoint::operator>(const FixedPoint &other) const {
+    return compare(other) > 0;
+}
+
+bool FixedPoint::operator<(const FixedPoint &other) const {
+    return compare(other) < 0;
+}
+
+bool FixedPoint::operator==(const FixedPoint &other) const {
+    return compare(other) == 0;
 }
 
 bool FixedPoint::operator<=(const FixedPoint &other) const {
-    return !(*this > other);
+    return compare(other) <= 0;
 }
 
 bool FixedPoint::operator>=(const FixedPoint &other) const {
-    return !(*this < other);
+    return compare(other) >= 0;
 }
 
 bool FixedPoint::operator!=(const FixedPoint &other) const {
-    return !(*this == other);
+    return compare(other) != 0;
 }
 
+/**
+ * @brief Прибавляет число на месте
+ * @param other Слагаемое
+ * @return *this
+ * @details Результат записывается в лимбы *this; память выделяется, только
+ * если сумма длиннее слагаемых (см. add_signed).
+ */
 FixedPoint& FixedPoint::operator+=(const FixedPoint &other) {
-    *this = *this + other;
+    add_signed(other, '+');
     return *this;
 }
 
+/**
+ * @brief Умножает на число на месте
+ * @param other Множитель
+ * @return *this
+ * @details Произведение лимбов строится в новом буфере, который становится
+ * буфером *this.
+ */
 FixedPoint& FixedPoint::operator*=(const FixedPoint &other) {
-    *this = *this * other;
+    LimbBuffer product(length + other.length);
+    size_t frac_sz = frac_limbs + other.frac_limbs;
+
+    if (&other == this) {
+        limbs::sqr(product.data(), limb_data(), length);
+    } else {
+        limbs::mul(product.data(), limb_data(), length, other.limb_data(), other.length);
+    }
+
+    assign_limbs(std::move(product), frac_sz);
+    is_negative = is_negative ^ other.is_negative;
     return *this;
 }
 
+/**
+ * @brief Вычитает число на месте
+ * @param other Вычитаемое
+ * @return *this
+ */
 FixedPoint& FixedPoint::operator-=(const FixedPoint &other) {
-    *this = *this - other;
+    add_signed(other, '-');
     return *this;
 }
 
+/**
+ * @brief Делит на число на месте
+ * @param other Делитель
+ * @return *this
+ * @throw std::runtime_error при делении на ноль
+ * @details Лимбы частного становятся буфером *this
+ */
 FixedPoint& FixedPoint::operator/=(const FixedPoint &other) {
-    *this = *this / other;
+    size_t frac_sz = frac_limbs + other.frac_limbs;
+    LimbBuffer quotient = divide(*this, other);
+
+    // Частное без дробной части получает один нулевой дробный лимб
+    if (frac_sz == 0) {
+        quotient.insert_zeros(1);
+        frac_sz = 1;
+    }
+    assign_limbs(std::move(quotient), frac_sz);
+    is_negative = is_negative ^ other.is_negative;
     return *this;
 }
 
-
 /**
  * @brief Устанавливает точность дробной части
  * @param precision Новое количество бит дробной части
@@ -364,9 +654,13 @@ void FixedPoint::set_precision(size_t precision) {
         return;
     }
 
+    // Младшие лимбы отбрасываются сдвигом начала окна
     if (precision == 0) {
-        fractional.clear();
+        offset += frac_limbs;
+        length -= frac_limbs;
+        frac_limbs = 0;
         fractional_bits = 0;
+        update_top();
         return;
     }
 
@@ -374,16 +668,19 @@ void FixedPoint::set_precision(size_t precision) {
     int low_order_bits = (fractional_bits % 32 ? fractional_bits % 32 : 32);
     if (need_to_del >= low_order_bits) {
         uint32_t q_del = (need_to_del - low_order_bits) / 32 + 1;
-        fractional.erase(fractional.begin(), fractional.begin() + q_del);
+        offset += q_del;
+        length -= q_del;
+        frac_limbs -= q_del;
 
-        if (!fractional.empty())
-            fractional[0] &= 0xFFFFFFFF << ((need_to_del - low_order_bits) % 32);
+        if (frac_limbs != 0)
+            limb_data()[0] &= 0xFFFFFFFF << ((need_to_del - low_order_bits) % 32);
         else
-            fractional.push_back(0);
+            extend_fraction(1);
     } else {
-        fractional[0] &= 0xFFFFFFFF << need_to_del;
+        limb_data()[0] &= 0xFFFFFFFF << need_to_del;
     }
     fractional_bits = precision;
+    update_top();
 }
 
 void FixedPoint::print_bin() const {
@@ -391,88 +688,335 @@ void FixedPoint::print_bin() const {
     std::cout << (is_negative ? "-" : "+") << std::endl;
     std::cout << "Fractional_bits: " << fractional_bits << std::endl;
     std::cout << "Integer bits:    ";
-    for (uint32_t value : integer) {
-        printBits(value);
+    for (size_t i = 0; i < int_size(); ++i) {
+        printBits(int_data()[i]);
         std::cout << " ";
     }
     std::cout << std::endl;
 
     std::cout << "Fractional bits: ";
-    for (uint32_t value : fractional) {
-        printBits(value);
+    for (size_t i = 0; i < frac_limbs; ++i) {
+        printBits(limb_data()[i]);
         std::cout << " ";
     }
     std::cout << std::endl;
 }
 
+/**
+ * @details Первые m цифр дроби - это целое floor(frac * 10^m), при
+ * округлении floor(frac * 10^m + 1/2): limbs::frac_digits читает только
+ * старшие лимбы дроби, нужные для m цифр. Если округление дало 10^m,
+ * цифры дроби - нули, а единица переносится в целую часть.
+ */
+FixedPoint::DecimalParts FixedPoint::decimal_parts(int digits, bool round) const {
+    DecimalParts parts{LimbBuffer(int_data(), int_data() + int_size()), LimbBuffer(), 0};
+
+    // Дробь без младших нулевых лимбов: по 8 цифр на лимб
+    const uint32_t *frac = limb_data();
+    size_t frac_sz = frac_limbs;
+    while (frac_sz > 0 && frac[frac_limbs - frac_sz] == 0) {
+        frac_sz--;
+    }
+    if (frac_sz == 0) {
+        return parts;
+    }
+    const uint32_t *frac_top = frac + (frac_limbs - frac_sz);
+
+    // Двоичная дробь из b бит после точки кончается ровно через b цифр
+    size_t max_digits = 8 * frac_sz;
+    size_t exact_digits = 32 * frac_sz - __builtin_ctz(frac_top[0]);
+    size_t limit = digits >= 0 ? std::min(max_digits, static_cast<size_t>(digits)) : max_digits;
+    bool rounded = false;
+    if (exact_digits <= limit) {
+        parts.frac_digits = exact_digits;
+    } else {
+        parts.frac_digits = limit;
+        rounded = round && limit < max_digits;
+    }
+    if (parts.frac_digits == 0 && !rounded) {
+        return parts;
+    }
+
+    parts.fraction = LimbBuffer(limbs::frac_digits_limbs(parts.frac_digits));
+    if (limbs::frac_digits(parts.fraction.data(), parts.frac_digits, frac_top, frac_sz, rounded)) {
+        parts.integer.push_back(0);
+        limbs::add_1(parts.integer.data(), parts.integer.data(), parts.integer.size(), 1);
+    }
+    return parts;
+}
+
+/**
+ * @details Целая часть переводится limbs::get_str, цифры дроби -
+ * limbs::get_str_padded, оба делением пополам.
+ *
+ * Дробь печатается не длиннее 8 цифр на каждый лимб до младшего ненулевого;
+ * если она кончается раньше, нули в конце не печатаются. При len != -1
+ * дробь длиннее len округляется до len цифр половиной вверх с переносом,
+ * в том числе в целую часть.
+ */
 std::string FixedPoint::to_string(int len) const {
-    FixedPoint ten = FixedPoint{"10"};
+    DecimalParts parts = decimal_parts(len, true);
+
+    std::string result = is_negative ? "-" : "";
+    size_t int_pos = result.size();
+    result.resize(int_pos + limbs::get_str_digits(parts.integer.size()));
+    result.resize(int_pos + limbs::get_str(&result[int_pos], parts.integer.data(), parts.integer.size()));
+    if (result.size() == int_pos) {
+        result += '0';
+    }
+    result += '.';
+
+    if (parts.frac_digits == 0) {
+        result += '0';
+        return result;
+    }
+    size_t frac_pos = result.size();
+    result.resize(frac_pos + parts.frac_digits);
+    limbs::get_str_padded(&result[frac_pos], parts.frac_digits, parts.fraction.data(), parts.fraction.size());
+    return result;
+}
+
+void FixedPoint::write_digits(std::ostream &out, int digits, bool round) const {
+    write_digits([&out](const char *data, size_t n) { out.write(data, static_cast<std::streamsize>(n)); },
+                 digits, round);
+}
+
+/**
+ * @details Порядок тот же, что у to_string, но целая часть и цифры дроби
+ * передаются limbs::write_str и limbs::write_str_padded блоками по мере
+ * перевода.
+ */
+void FixedPoint::write_digits(const DigitSink &sink, int digits, bool round) const {
+    DecimalParts parts = decimal_parts(digits, round);
 
-    FixedPoint before = *this;
+    if (is_negative) {
+        sink("-", 1);
+    }
+    if (limbs::normalized_size(parts.integer.data(), parts.integer.size()) == 0) {
+        sink("0", 1);
+    } else {
+        limbs::write_str(sink, parts.integer.data(), parts.integer.size());
+    }
+    sink(".", 1);
 
-    before.set_precision(0);
+    if (parts.frac_digits == 0) {
+        sink("0", 1);
+    } else {
+        limbs::write_str_padded(sink, parts.frac_digits, parts.fraction.data(), parts.fraction.size());
+    }
+}
 
-    FixedPoint after = *this - before;
+/**
+ * @details Цифры целой части переводятся прямо в лимбы value, дробной -
+ * limbs::set_frac_str; раскладка та же, что у конструктора из строки:
+ * ceil(frac_bits / 32) дробных лимбов и хотя бы один целый.
+ */
+std::from_chars_result from_chars(const char *first, const char *last, FixedPoint &value, int frac_bits) {
+    auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+    const char *pos = first;
+    bool negative = pos != last && *pos == '-';
+    if (pos != last && (*pos == '-' || *pos == '+')) {
+        ++pos;
+    }
+    const char *int_first = pos;
+    pos = std::find_if_not(pos, last, is_digit);
+    const char *int_last = pos;
+    const char *frac_first = pos, *frac_last = pos;
+    if (pos != last && *pos == '.') {
+        frac_first = pos + 1;
+        frac_last = std::find_if_not(frac_first, last, is_digit);
+    }
+    if (frac_bits < 0 || (int_first == int_last && frac_first == frac_last)) {
+        return {first, std::errc::invalid_argument};
+    }
+    int_first = std::find_if(int_first, int_last, [](char c) { return c != '0'; });
+
+    size_t frac_sz = (static_cast<size_t>(frac_bits) + 31) / 32;
+    size_t int_digits = static_cast<size_t>(int_last - int_first);
+    CharsScratch scratch(frac_sz + limbs::set_str_limbs(int_digits));
+    LimbBuffer &buffer = value.limb_buffer;
+    buffer.resize(frac_sz + limbs::set_str_limbs(int_digits));
+
+    size_t int_sz = limbs::set_str(buffer.data() + frac_sz, int_first, int_digits);
+    size_t frac_digits = static_cast<size_t>(frac_last - frac_first);
+    if (frac_sz != 0 && frac_digits != 0) {
+        limbs::set_frac_str(buffer.data(), frac_sz, frac_first, frac_digits);
+        // Биты младше frac_bits отбрасываются
+        unsigned drop = static_cast<unsigned>(32 * frac_sz - frac_bits);
+        if (drop != 0) {
+            buffer[0] &= ~((uint32_t(1) << drop) - 1);
+        }
+    } else {
+        std::fill(buffer.begin(), buffer.begin() + frac_sz, 0);
+    }
+    if (int_sz == 0) {
+        buffer[frac_sz] = 0;
+    }
+    buffer.resize(frac_sz + std::max<size_t>(int_sz, 1));
+
+    value.offset = 0;
+    value.frac_limbs = frac_sz;
+    value.length = buffer.size();
+    value.update_top();
+    value.fractional_bits = static_cast<uint32_t>(frac_bits);
+    value.is_negative = negative;
+    return {frac_first == int_last ? int_last : frac_last, std::errc()};
+}
 
-    std::string before_res;
-    while (!before.is_zero()) {
-        FixedPoint cur = before / ten;
-        cur.set_precision(0);
-        FixedPoint rem = before - (cur * ten);
-        before_res.push_back('0' + rem.integer[0]);
+std::from_chars_result from_chars(std::string_view str, FixedPoint &value, int frac_bits) {
+    return from_chars(str.data(), str.data() + str.size(), value, frac_bits);
+}
 
-        before = cur;
+/**
+ * @details Если места хватает с запасом limbs::get_str_digits на целую
+ * часть, точная длина не вычисляется.
+ */
+std::to_chars_result to_chars(char *first, char *last, const FixedPoint &value, int digits) {
+    CharsScratch scratch(value.length);
+    FixedPoint::DecimalParts parts = value.decimal_parts(digits, true);
+    const uint32_t *int_part = parts.integer.data();
+    size_t int_sz = limbs::normalized_size(int_part, parts.integer.size());
+
+    size_t available = static_cast<size_t>(last - first);
+    size_t tail = 1 + std::max<size_t>(parts.frac_digits, 1) + (value.is_negative ? 1 : 0);
+    if (available < tail + limbs::get_str_digits(int_sz) &&
+        available < tail + std::max<size_t>(limbs::decimal_digits(int_part, int_sz), 1)) {
+        return {last, std::errc::value_too_large};
     }
 
-    if (before_res == "") {
-        before_res = "0";
+    char *pos = first;
+    if (value.is_negative) {
+        *pos++ = '-';
+    }
+    size_t written = limbs::get_str(pos, int_part, int_sz);
+    if (written == 0) {
+        *pos++ = '0';
     }
+    pos += written;
+    *pos++ = '.';
+    if (parts.frac_digits == 0) {
+        *pos++ = '0';
+    } else {
+        limbs::get_str_padded(pos, parts.frac_digits, parts.fraction.data(), parts.fraction.size());
+        pos += parts.frac_digits;
+    }
+    return {pos, std::errc()};
+}
 
-    std::reverse(before_res.begin(), before_res.end());
+size_t to_chars_size(const FixedPoint &value, int digits) {
+    CharsScratch scratch(value.length);
+    FixedPoint::DecimalParts parts = value.decimal_parts(digits, true);
+    size_t int_digits = limbs::decimal_digits(parts.integer.data(), parts.integer.size());
+    return (value.is_negative ? 1 : 0) + std::max<size_t>(int_digits, 1) + 1 + std::max<size_t>(parts.frac_digits, 1);
+}
 
-    std::string after_res;
-    int stop = after.fractional_bits;
-    while (!after.is_zero() && stop > 0) {
-        FixedPoint cur = after * ten;
-        FixedPoint rem = after * ten;
-        rem.set_precision(0);
+/**
+ * @brief Пересчитывает top - число значащих лимбов в окне [0, length)
+ */
+void FixedPoint::update_top() {
+    top = limbs::normalized_size(limb_data(), length);
+}
 
-        after_res.push_back('0' + rem.integer[0]);
+LimbBuffer FixedPoint::joined_limbs(size_t extra) const {
+    LimbBuffer result;
+    result.reserve(length + extra);
+    result.assign(limb_data(), limb_data() + length);
+    result.resize(length + extra);
+    return result;
+}
 
-        after = cur - rem;
-        stop -= 4;
+void FixedPoint::assign_limbs(LimbBuffer &&data, size_t frac_sz) {
+    limb_buffer = std::move(data);
+    offset = 0;
+    frac_limbs = frac_sz;
+    length = limb_buffer.size();
+    if (length == frac_sz) {
+        limb_buffer.push_back(0);
+        length++;
     }
+    normalize();
+}
 
-    if (after_res == "") {
-        after_res = "0";
+void FixedPoint::assign_scaled(const uint32_t *mag, size_t n, long long exp, int frac_bits) {
+    size_t frac_sz = frac_bits <= 0 ? 0 : (static_cast<size_t>(frac_bits) + 31) / 32;
+    // Позиция младшего бита mag относительно начала буфера
+    long long pos = exp + 32 * static_cast<long long>(frac_sz);
+    long long end_bit = pos + 32 * static_cast<long long>(n);
+    size_t total = std::max<size_t>(frac_sz + 1, end_bit > 0 ? static_cast<size_t>((end_bit + 31) / 32) : 0);
+
+    limb_buffer.clear();
+    limb_buffer.resize(total);
+    for (size_t i = 0; i < n; ++i) {
+        long long bit = pos + 32 * static_cast<long long>(i);
+        if (bit <= -32 || mag[i] == 0) continue;
+        if (bit < 0) {
+            limb_buffer[0] |= mag[i] >> (-bit);
+            continue;
+        }
+        size_t word = static_cast<size_t>(bit / 32);
+        unsigned shift = static_cast<unsigned>(bit % 32);
+        limb_buffer[word] |= mag[i] << shift;
+        if (shift != 0) {
+            limb_buffer[word + 1] |= mag[i] >> (32 - shift);
+        }
     }
 
-    if (len != -1 && after_res.size() > (uint32_t) len) {
-        after_res.resize(len + 1);
-        after_res[after_res.size() - 2] += static_cast<uint32_t>(after_res[after_res.size() - 1] >= '5');
-        after_res.pop_back();
+    // Биты младше frac_bits отбрасываются
+    unsigned drop = static_cast<unsigned>(32 * frac_sz - (frac_bits <= 0 ? 0 : frac_bits));
+    if (drop != 0) {
+        limb_buffer[0] &= ~((uint32_t(1) << drop) - 1);
     }
 
-    if (is_negative) {
-        return "-" + before_res + "." + after_res;
+    size_t len = total;
+    while (len > frac_sz + 1 && limb_buffer[len - 1] == 0) {
+        len--;
     }
+    limb_buffer.resize(len);
+    offset = 0;
+    frac_limbs = frac_sz;
+    length = len;
+    update_top();
+}
 
-    return before_res + "." + after_res;
+void FixedPoint::assign_parts(const std::vector<uint32_t> &int_part, const std::vector<uint32_t> &frac_part) {
+    limb_buffer.resize(frac_part.size() + int_part.size());
+    std::copy(frac_part.begin(), frac_part.end(), limb_buffer.begin());
+    std::copy(int_part.begin(), int_part.end(), limb_buffer.begin() + frac_part.size());
+    offset = 0;
+    frac_limbs = frac_part.size();
+    length = limb_buffer.size();
+    update_top();
 }
 
 /**
- * @brief Проверяет, является ли число нулем
- * @return true если число равно нулю
+ * @details Если под окном числа не хватает запаса, буфер расширяется снизу
  */
-bool FixedPoint::is_zero() const {
-    if (integer.size() == 0 && fractional.size() == 0) return true;
-    for (uint32_t val : integer) {
-        if (val != 0) return false;
+void FixedPoint::extend_fraction(size_t count) {
+    if (offset < count) {
+        limb_buffer.insert_zeros(count - offset);
+        offset = count;
     }
-    for (uint32_t val : fractional) {
-        if (val != 0) return false;
+    offset -= count;
+    std::fill(limb_buffer.begin() + offset, limb_buffer.begin() + offset + count, 0);
+    frac_limbs += count;
+    length += count;
+    if (top != 0) top += count;
+}
+
+/**
+ * @details Если над окном числа не хватает запаса, окно сначала сдвигается
+ * в начало буфера, и только потом буфер растёт
+ */
+void FixedPoint::extend_integer(size_t count) {
+    if (offset + length + count > limb_buffer.size() && offset != 0) {
+        std::copy(limb_buffer.begin() + offset, limb_buffer.begin() + offset + length, limb_buffer.begin());
+        offset = 0;
+    }
+    if (offset + length + count > limb_buffer.size()) {
+        limb_buffer.resize(offset + length + count);
     }
-    return true;
+    std::fill(limb_buffer.begin() + offset + length, limb_buffer.begin() + offset + length + count, 0);
+    length += count;
 }
 
 Op_behavior FixedPoint::helper(const FixedPoint &a, const FixedPoint &b, char op) const {
@@ -500,424 +1044,235 @@ void FixedPoint::printBits(uint32_t value) const {
 }
 
 /**
- * @brief Сравнивает абсолютные значения двух чисел
- * @param a Первое число
- * @param b Второе число
- * @return true если |a| > |b|
+ * @details Сначала сравниваются порядки старших значащих лимбов относительно
+ * точки, затем лимбы сверху вниз, пока у обоих чисел они есть. Если остались
+ * младшие лимбы только у одного числа, больше то, у которого они ненулевые.
  */
-bool FixedPoint::bigger_abs(const FixedPoint &a, const FixedPoint &b) const {
-    for (int i = std::max(a.integer.size(), b.integer.size()) - 1; i >= 0; i--) {
-        uint32_t val_a = ((uint32_t) i) < a.integer.size() ? a.integer[i] : 0;
-        uint32_t val_b = ((uint32_t) i) < b.integer.size() ? b.integer[i] : 0;
-        if (val_a > val_b) {
-            return true;
-        }
-        if (val_a < val_b) {
-            return false;
-        }
+int FixedPoint::compare_abs(const FixedPoint &a, const FixedPoint &b) {
+    if (a.top == 0 || b.top == 0) {
+        return (a.top != 0) - (b.top != 0);
     }
 
-    int a_i = a.fractional.size() - 1, b_i = b.fractional.size() - 1;
-    for (; a_i >= 0 && b_i >= 0; a_i--, b_i--) {
-        if (a.fractional[a_i] > b.fractional[b_i]) {
-            return true;
-        }
-        if (a.fractional[a_i] < b.fractional[b_i]) {
-            return false;
-        }
+    ptrdiff_t a_order = static_cast<ptrdiff_t>(a.top) - static_cast<ptrdiff_t>(a.frac_limbs);
+    ptrdiff_t b_order = static_cast<ptrdiff_t>(b.top) - static_cast<ptrdiff_t>(b.frac_limbs);
+    if (a_order != b_order) {
+        return a_order > b_order ? 1 : -1;
     }
 
-    if (a_i == -1 && b_i == -1) return false;
-    if (a_i == -1) return false;
-    return true;
-}
-
-/**
- * @brief Сравнивает абсолютные значения двух чисел
- * @param a Первое число
- * @param b Второе число
- * @return true если |a| < |b|
- */
-bool FixedPoint::less_abs(const FixedPoint &a, const FixedPoint &b) const {
-    for (int i = std::max(a.integer.size(), b.integer.size()) - 1; i >= 0; i--) {
-        uint32_t val_a = ((uint32_t) i) < a.integer.size() ? a.integer[i] : 0;
-        uint32_t val_b = ((uint32_t) i) < b.integer.size() ? b.integer[i] : 0;
-        if (val_a < val_b) {
-            return true;
-        }
-        if (val_a > val_b) {
-            return false;
+    const uint32_t *a_data = a.limb_data(), *b_data = b.limb_data();
+    size_t a_i = a.top, b_i = b.top;
+    for (; a_i > 0 && b_i > 0; a_i--, b_i--) {
+        if (a_data[a_i - 1] != b_data[b_i - 1]) {
+            return a_data[a_i - 1] > b_data[b_i - 1] ? 1 : -1;
         }
     }
 
-    int a_i = a.fractional.size() - 1, b_i = b.fractional.size() - 1;
-    for (; a_i >= 0 && b_i >= 0; a_i--, b_i--) {
-        if (a.fractional[a_i] < b.fractional[b_i]) {
-            return true;
-        }
-        if (a.fractional[a_i] > b.fractional[b_i]) {
-            return false;
-        }
-    }
-    if (a_i == -1 && b_i == -1) return false;
-    if (b_i == -1) return false;
-    return true;
+    if (limbs::normalized_size(a_data, a_i) != 0) return 1;
+    if (limbs::normalized_size(b_data, b_i) != 0) return -1;
+    return 0;
 }
 
 /**
- * @brief Выполняет сложение дробных частей
- * @param a Первая дробная часть
- * @param b Вторая дробная часть
- * @param carry Флаг переноса
- * @return Пару: результат и новый флаг переноса
+ * @brief Прибавляет или вычитает число на месте
+ * @param other Второй операнд
+ * @param op '+' или '-'
+ * @details Окно *this расширяется нулевыми лимбами до длин дробной и целой
+ * частей other, после чего модули складываются или вычитаются одним
+ * проходом по лимбам: лимбы other совпадают с верхней частью окна *this
+ * начиная с frac_limbs - other.frac_limbs. Если при вычитании
+ * |*this| < |other|, в лимбах остаётся дополнительный код разности: он
+ * обращается, а знак меняется. Знак при равных модулях такой же, как у *this.
  */
-std::pair<std::vector<uint32_t>, bool> FixedPoint::add_frac(const std::vector<uint32_t> &a,
-                                                            const std::vector<uint32_t> &b,
-                                                            uint32_t carry) const {
-    std::vector<uint32_t> result;
-    size_t max_sz = std::max(a.size(), b.size());
-
-    size_t a_i = 0, b_i = 0;
-
-    // Perform addition bit by bit
-    while (a_i < max_sz && b_i < max_sz) {
-        if (b_i < max_sz - a.size()) {
-            result.push_back(b[b_i++]);
-            continue;
-        }
-        if (a_i < max_sz - b.size()) {
-            result.push_back(a[a_i++]);
-            continue;
-        }
-
-        result.push_back(0);
-
-        for (size_t j = 0; j < 32; ++j) {
-            uint32_t addition = (carry == 1 ? 0xFFFFFFFF : 0);
-            result.back() = result.back() | ((a[a_i] ^ b[b_i] ^ addition) & (1 << j));
-            carry = (((a[a_i] & (1 << j)) && (b[b_i] & (1 << j))) ||
-                    (((a[a_i] ^ b[b_i]) & (1 << j)) && addition) ? 1 : 0);
-        }
-        a_i++;
-        b_i++;
-    }
-    return std::make_pair(result, carry);
+void FixedPoint::add_signed(const FixedPoint &other, char op) {
+    Op_behavior behavior = helper(*this, other, op);
+    accumulate(other, behavior == Op_behavior::PLUS_SND || behavior == Op_behavior::SUB_FST);
+    normalize();
 }
 
 /**
- * @brief Выполняет сложение целых частей
- * @param a Первая целая часть
- * @param b Вторая целая часть
- * @param carry Флаг переноса
- * @return Пару: результат и новый флаг переноса
+ * @details Общая часть add_signed и совмещённых операций: результат не
+ * нормализуется, поэтому в одно окно можно последовательно прибавить
+ * несколько слагаемых. Нормализация перед вызовом не требуется.
  */
-std::pair<std::vector<uint32_t>, bool> FixedPoint::add_int(const std::vector<uint32_t> &a,
-                                                           const std::vector<uint32_t> &b,
-                                                           uint32_t carry) const {
-    std::vector<uint32_t> result;
-    size_t max_sz = std::max(a.size(), b.size());
-
-    for (size_t i = 0; i < max_sz; ++i) {
-        if (i >= a.size()) {
-            result.push_back(b[i] + carry);
-            carry = (b[i] + carry) == 0;
-            continue;
-        }
-        if (i >= b.size()) {
-            result.push_back(a[i] + carry);
-            carry = (a[i] + carry) == 0;
-            continue;
-        }
-
-        result.push_back(0);
-
-        for (size_t j = 0; j < 32; ++j) {
-            uint32_t addition = (carry == 1 ? 0xFFFFFFFF : 0);
-            result.back() = result.back() | ((a[i] ^ b[i] ^ addition) & (1 << j));
-            carry = (((a[i] & (1 << j)) && (b[i] & (1 << j))) ||
-                    (((a[i] ^ b[i]) & (1 << j)) && addition) ? 1 : 0);
-        }
+void FixedPoint::accumulate(const FixedPoint &other, bool add_abs) {
+    if (frac_limbs < other.frac_limbs) {
+        extend_fraction(other.frac_limbs - frac_limbs);
+    }
+    if (int_size() < other.int_size()) {
+        extend_integer(other.int_size() - int_size());
     }
-    return std::make_pair(result, carry);
-}
-
-std::pair<std::vector<uint32_t>, std::vector<uint32_t>>
-FixedPoint::subtract_nums(const FixedPoint &a, const FixedPoint &b) const {
-    std::vector<uint32_t> result_int;
-    std::vector<uint32_t> result_frac;
-
-    size_t a_int_sz = a.integer.size();
-    size_t a_frac_sz = a.fractional.size();
-    size_t b_int_sz = b.integer.size();
-    size_t b_frac_sz = b.fractional.size();
-
-
-    size_t max_sz = std::max(a_int_sz + a_frac_sz, b_int_sz + b_frac_sz);
-    size_t max_frac_sz = std::max(a_frac_sz, b_frac_sz);
-
-    uint32_t borrow = 0; 
-
-    size_t a_i = 0, b_i = 0;
-
-    
-    while (a_i < max_sz && b_i < max_sz) {
-        if (a_i < max_frac_sz && b_i < max_frac_sz) {
-            result_frac.push_back(0); 
-        } else {
-            result_int.push_back(0); 
-        }
 
-       
-        if (b_i < max_frac_sz - a_frac_sz) {
-            borrow = subtract(result_frac.back(), 0, b.fractional[b_i++], borrow);
-            continue;
+    size_t shift = frac_limbs - other.frac_limbs;
+    uint32_t *top = limb_data() + shift;
+    if (add_abs) {
+        if (limbs::add(top, top, length - shift, other.limb_data(), other.length) != 0) {
+            extend_integer(1);
+            int_data()[int_size() - 1] = 1;
         }
-
-        if (a_i < max_frac_sz - b_frac_sz) {
-            borrow = subtract(result_frac.back(), a.fractional[a_i++], 0, borrow);
-            continue;
-        }
-
-      
-        if (a_i < max_frac_sz && b_i < max_frac_sz) {
-            borrow = subtract(result_frac.back(), a.fractional[a_i++], b.fractional[b_i++], borrow);
-            continue;
+    } else {
+        if (limbs::sub(top, top, length - shift, other.limb_data(), other.length) != 0) {
+            uint32_t *data = limb_data();
+            for (size_t i = 0; i < length; ++i) data[i] = ~data[i];
+            limbs::add_1(data, data, length, 1);
+            is_negative = !is_negative;
         }
-
-        
-        uint32_t val_a = (a_i - a_frac_sz < a_int_sz) ? a.integer[a_i++ - a_frac_sz] : 0;
-        uint32_t val_b = (b_i - b_frac_sz < b_int_sz) ? b.integer[b_i++ - b_frac_sz] : 0;
-        borrow = subtract(result_int.back(), val_a, val_b, borrow);
     }
-
-    return std::make_pair(result_int, result_frac);
 }
 
-
-int FixedPoint::subtract(uint32_t &res, uint32_t val_a, uint32_t val_b, uint32_t borrow) const {
-    uint32_t int_res = val_a ^ val_b;
-    for (size_t bit_i = 0; bit_i < 32; bit_i++) {
-        switch (borrow) {
-        case 0:
-            res = res | (int_res & (1 << bit_i));
-            if ((val_a & (1 << bit_i)) == 0 && (val_b & (1 << bit_i)) != 0) {
-                borrow = 1; 
-            }
-            break;
-        case 1:
-            res = res | ((~int_res) & (1 << bit_i));
-            if ((val_a & (1 << bit_i)) != 0 && (val_b & (1 << bit_i)) == 0) {
-                borrow = 0; 
-            }
-            break;
-        }
+FixedPoint FixedPoint::raw_product(const FixedPoint &a, const FixedPoint &b) {
+    FixedPoint result;
+    result.limb_buffer.resize(a.length + b.length);
+    if (&a == &b) {
+        limbs::sqr(result.limb_buffer.data(), a.limb_data(), a.length);
+    } else {
+        limbs::mul(result.limb_buffer.data(), a.limb_data(), a.length, b.limb_data(), b.length);
     }
-    return borrow;
+    result.frac_limbs = a.frac_limbs + b.frac_limbs;
+    result.length = a.length + b.length;
+    result.update_top();
+    result.is_negative = a.is_negative ^ b.is_negative;
+    return result;
 }
 
-std::vector<uint32_t> FixedPoint::subtract_vec(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b) const {
-    uint32_t borrow = 0; 
-
-    uint32_t a_i = 0, b_i = 0;
-    uint32_t max_sz = std::max(a.size(), b.size());
-
-    std::vector<uint32_t> result;
-
-  
-    while (a_i < max_sz && b_i < max_sz) {
-        result.push_back(0);
-
-        uint32_t val_a = (a_i < a.size()) ? a[a_i++] : 0;
-        uint32_t val_b = (b_i < b.size()) ? b[b_i++] : 0;
-        borrow = subtract(result.back(), val_a, val_b, borrow);
-    }
+FixedPoint fma(const FixedPoint &a, const FixedPoint &b, const FixedPoint &c) {
+    FixedPoint result = FixedPoint::raw_product(a, b);
+    result.accumulate(c, result.is_negative == c.is_negative);
+    result.normalize();
     return result;
 }
 
-std::pair<std::vector<uint32_t>, std::vector<uint32_t>>
-FixedPoint::divide(const FixedPoint &a, const FixedPoint &b) const {
-
-    std::vector<uint32_t> result_int;
-    std::vector<uint32_t> result_frac;
-
-    uint32_t a_int_sz  = a.integer.size();
-    uint32_t a_frac_sz = a.fractional.size();
-    uint32_t b_frac_sz = b.fractional.size();
-
-    uint32_t a_sz = a_int_sz + a_frac_sz;
-
-    FixedPoint Remainder{0, 0};
-    uint32_t bit_taken = 0;
+FixedPoint fmma(const FixedPoint &a, const FixedPoint &b, const FixedPoint &c, const FixedPoint &d) {
+    FixedPoint result = FixedPoint::raw_product(a, b);
+    FixedPoint cd = FixedPoint::raw_product(c, d);
+    result.accumulate(cd, result.is_negative == cd.is_negative);
+    result.normalize();
+    return result;
+}
 
-    FixedPoint Divider{0, 0};
-    std::vector<uint32_t> divider(b.fractional);
-    divider.insert(divider.end(), b.integer.begin(), b.integer.end());
+FixedPoint fmms(const FixedPoint &a, const FixedPoint &b, const FixedPoint &c, const FixedPoint &d) {
+    FixedPoint result = FixedPoint::raw_product(a, b);
+    FixedPoint cd = FixedPoint::raw_product(c, d);
+    result.accumulate(cd, result.is_negative != cd.is_negative);
+    result.normalize();
+    return result;
+}
 
-    if (divider.empty()) {
-        throw std::runtime_error("Attempted division by zero");
+FixedPoint sum_of(std::initializer_list<std::reference_wrapper<const FixedPoint>> terms) {
+    if (terms.size() == 0) {
+        throw std::invalid_argument("sum_of needs at least one term");
     }
 
-    Divider.integer = divider;
-
-    for (uint32_t bit_i = 0; bit_i < (a_sz + 2 * b_frac_sz) * 32; bit_i++) {
-
-        uint32_t addition;
-
-        if (bit_i < a_int_sz * 32) {
-            addition = ((a.integer[a_int_sz - 1 - (bit_i / 32)] >> (31 - bit_taken)) & 0x00000001);
-            add_bit_div(Remainder.integer, bit_i, addition);
-        } else if (bit_i < (a_int_sz + a_frac_sz) * 32) {
-            addition = ((a.fractional[a_frac_sz - 1 - ((bit_i - a_int_sz * 32) / 32)] >> (31 - bit_taken)) & 0x00000001);
-            add_bit_div(Remainder.integer, bit_i, addition);
-        } else {
-            add_bit_div(Remainder.integer, bit_i, false);
-        }
-
-        bit_taken = (bit_taken + 1) % 32;
-
-        if (Remainder >= Divider) {
-            Remainder -= Divider;
-            if (bit_i / 32 < a_int_sz + b_frac_sz)
-                add_bit_div(result_int, bit_i, true);
-            else
-                add_bit_div(result_frac, bit_i, true);
-        } else {
-            if (bit_i / 32 < a_int_sz + b_frac_sz)
-                add_bit_div(result_int, bit_i, false);
-            else
-                add_bit_div(result_frac, bit_i, false);
-        }
+    size_t frac_sz = 0, int_sz = 0;
+    for (const FixedPoint &term : terms) {
+        frac_sz = std::max(frac_sz, term.frac_limbs);
+        int_sz = std::max(int_sz, term.int_size());
     }
 
-    return std::make_pair(result_int, result_frac);
-}
-
-bool FixedPoint::not_less_vec(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b) const {
-
-    for (int i = std::max(a.size(), b.size()) - 1; i >= 0; i--) {
-        uint32_t val_a = (((uint32_t) i) < a.size() ? a[i] : 0);
-        uint32_t val_b = (((uint32_t) i) < b.size() ? b[i] : 0);
-        if (val_a > val_b) {
-            return true;
-        }
-        if (val_a < val_b) {
-            return false;
-        }
+    // Окно результата сразу выделяется под все слагаемые, запас в один лимб
+    // сверху поглощает переносы большинства сумм
+    const FixedPoint &first = *terms.begin();
+    FixedPoint result;
+    result.limb_buffer.resize(frac_sz + int_sz + 1);
+    std::copy(first.limb_data(), first.limb_data() + first.length,
+              result.limb_buffer.begin() + (frac_sz - first.frac_limbs));
+    result.frac_limbs = frac_sz;
+    result.length = frac_sz + int_sz + 1;
+    result.is_negative = first.is_negative;
+
+    for (auto it = terms.begin() + 1; it != terms.end(); ++it) {
+        const FixedPoint &term = *it;
+        result.accumulate(term, result.is_negative == term.is_negative);
     }
-
-    return true;
+    result.normalize();
+    return result;
 }
 
-void FixedPoint::add_bit_div(std::vector<uint32_t> &vec, uint32_t bit_added, bool is_one) const {
-    if (bit_added % 32 == 0 || vec.back() & 0x80000000) vec.push_back(0);
-    for (uint32_t i = vec.size() - 1; i > 0; i--) {
-        vec[i] <<= 1;
-        vec[i] |= vec[i - 1] >> 31;
-    }
-    vec[0] <<= 1;
-    vec[0] |= (is_one ? 1 : 0);
+/**
+ * @brief Убирает младшие нулевые лимбы дробной части и старшие нулевые
+ * лимбы целой части, оставляя хотя бы по одному
+ * @details Лимбы не перемещаются: меняются только границы окна
+ */
+void FixedPoint::normalize() {
+    const uint32_t *data = limb_data();
+    size_t low = 0;
+    while (low + 1 < frac_limbs && data[low] == 0) low++;
+    offset += low;
+    frac_limbs -= low;
+    length -= low;
+
+    while (int_size() > 1 && int_data()[int_size() - 1] == 0) length--;
+
+    fractional_bits = frac_limbs * 32;
+    update_top();
 }
 
 /**
- * @brief Преобразует целую часть из десятичной строки в двоичную
- * @param num_str Десятичная строка
- * @return Двоичное представление целой части
+ * @brief Делит модули двух чисел
+ * @param a Делимое
+ * @param b Делитель
+ * @return Лимбы частного: a.frac_limbs + b.frac_limbs дробных и
+ * a.int_size() + b.frac_limbs целых
+ * @throw std::runtime_error при делении на ноль
+ * @details Лимбы делимого, дополненные снизу 2 * b.frac_limbs нулевыми
+ * лимбами, делятся нацело на лимбы делителя через limbs::divrem; частное
+ * усекается.
  */
-std::vector<uint32_t> FixedPoint::int_part_to_bin(const std::string &num_str) const {
-    std::string cur_num_str = num_str;  
-    std::vector<uint32_t> binary_result; 
-
-    if (cur_num_str == "0") {
-        binary_result.push_back(0);
-        return binary_result;
+LimbBuffer FixedPoint::divide(const FixedPoint &a, const FixedPoint &b) const {
+    size_t divider_sz = limbs::normalized_size(b.limb_data(), b.length);
+    if (divider_sz == 0) {
+        throw std::runtime_error("Attempted division by zero");
     }
 
-    int bit_added = 0;
-
-  
-    while (cur_num_str != "0") {
-        int remainder = 0;
-        std::string result;
-
-        for (char digit_c : cur_num_str) {
-            int cur_digit = (digit_c - '0') + remainder * 10;
-            int quotient = cur_digit / 2;
-            remainder = cur_digit % 2;
-
-            result += std::to_string(quotient);
-        }
-
-    
-        result.erase(0, result.find_first_not_of('0'));
-        if (result.empty()) {
-            result = "0";
-        }
-
-        if (bit_added == 0) binary_result.push_back(0);
+    LimbBuffer dividend(2 * b.frac_limbs + a.length);
+    std::copy(a.limb_data(), a.limb_data() + a.length, dividend.begin() + 2 * b.frac_limbs);
 
-        binary_result.back() = binary_result.back() | (remainder << bit_added);
-
-        cur_num_str = result;
-        bit_added = (bit_added + 1) % 32;
+    LimbBuffer quotient(dividend.size());
+    size_t dividend_sz = limbs::normalized_size(dividend.data(), dividend.size());
+    if (dividend_sz >= divider_sz) {
+        limbs::divrem(quotient.data(), nullptr, dividend.data(), dividend_sz, b.limb_data(), divider_sz);
     }
 
-    return binary_result;
+    return quotient;
 }
 
 /**
- * @brief Умножает десятичную строку на 2
- * @param num_str Входная строка
- * @return Результат умножения в виде строки
+ * @brief Преобразует целую часть из десятичной строки в двоичную
+ * @param num_str Десятичная строка
+ * @return Двоичное представление целой части, не короче одного лимба
+ * @details Перевод ведётся limbs::set_str: блоками по 9 цифр, а для
+ * длинных строк - делением пополам с умножением на степени десяти
  */
-std::string FixedPoint::mult_by_two(const std::string &num_str) const {
-    std::string result = "";
-    int carry = 0;
-
-    for (int i = num_str.size() - 1; i >= 0; i--) {
-        int value = (num_str[i] - '0') * 2 + carry;
-        carry = value / 10;
-        result = std::to_string(value % 10) + result;
-    }
-
-    if (carry > 0) {
-        result = std::to_string(carry) + result;
+std::vector<uint32_t> FixedPoint::int_part_to_bin(const std::string &num_str) const {
+    std::vector<uint32_t> binary_result(limbs::set_str_limbs(num_str.size()));
+    size_t len = limbs::set_str(binary_result.data(), num_str.data(), num_str.size());
+    binary_result.resize(std::max<size_t>(len, 1));
+    if (len == 0) {
+        binary_result[0] = 0;
     }
-
-    return result;
+    return binary_result;
 }
 
 /**
  * @brief Преобразует дробную часть из десятичной строки в двоичную
  * @param frac_str Дробная часть в виде строки
  * @param frac_bits Требуемое количество бит
- * @return Двоичное представление дробной части
+ * @return Двоичное представление дробной части: floor(N * 2^frac_bits / 10^d)
+ * для d цифр N, выровненное к старшему биту ceil(frac_bits / 32) лимбов
  */
 std::vector<uint32_t> FixedPoint::frac_to_binary(const std::string &frac_str, int frac_bits) const {
-    std::vector<uint32_t> binary;
-    std::string frac_part = frac_str;
-    uint32_t frac_part_size = frac_part.size();
-
-    for (int i = 0, bit_added = 0; i < frac_bits && !frac_part.empty(); ++i, bit_added = (bit_added + 1) % 32) {
-     
-        std::string multiplied = mult_by_two(frac_part);
-
-        if (bit_added == 0) binary.insert(binary.begin(), 0);
+    if (frac_bits <= 0 || frac_str.empty()) {
+        return {};
+    }
 
-        if (multiplied.size() == frac_part_size) {
-            binary[0] = (binary[0] << 1) | 0;
-            frac_part = multiplied;
-        } else {
-            binary[0] = (binary[0] << 1) | 1;
-            frac_part = multiplied.substr(1);
-        }
+    size_t frac_sz = (static_cast<size_t>(frac_bits) + 31) / 32;
+    std::vector<uint32_t> binary(frac_sz);
+    limbs::set_frac_str(binary.data(), frac_sz, frac_str.data(), frac_str.size());
 
-        if (multiplied.size() == 0) {
-            frac_part = "0";
-        }
+    // Биты младше frac_bits отбрасываются
+    unsigned drop = static_cast<unsigned>(32 * frac_sz - frac_bits);
+    if (drop != 0) {
+        binary[0] &= ~((uint32_t(1) << drop) - 1);
     }
-    if (!binary.empty())
-        binary[0] <<= 32 - (frac_bits % 32);
-
     return binary;
 }
 
@@ -963,21 +1318,54 @@ FixedPoint::decimal_to_binary(const std::string& num_str, int frac_bits) const {
 //сдвиг влево
 FixedPoint FixedPoint::operator<<(int n) const {
     FixedPoint result = *this;
-    for (int i = 0; i < n; ++i) {
-        result = result * FixedPoint("2.0");
-    }
+    result.scale_by_pow2(n);
     return result;
 }
 
 //сдвиг вправо
 FixedPoint FixedPoint::operator>>(int n) const {
     FixedPoint result = *this;
-    for (int i = 0; i < n; ++i) {
-        result = result / FixedPoint("2.0");
-    }
+    result.scale_by_pow2(-static_cast<long long>(n));
     return result;
 }
 
+FixedPoint &FixedPoint::scale_by_pow2(long long exp) {
+    if (exp == 0) {
+        return *this;
+    }
+
+    // 2^exp = 2^bits * B^limb_shift, 0 <= bits < 32
+    long long limb_shift = exp >= 0 ? exp / 32 : -((-exp + 31) / 32);
+    unsigned bits = static_cast<unsigned>(exp - limb_shift * 32);
+
+    if (bits != 0) {
+        extend_integer(1);
+        limbs::lshift(limb_data(), limb_data(), length, bits);
+    }
+
+    if (limb_shift > 0) {
+        // Точка переносится вниз; недостающие младшие лимбы - нули целой части
+        size_t shift = static_cast<size_t>(limb_shift);
+        if (shift > frac_limbs) {
+            extend_fraction(shift - frac_limbs);
+        }
+        frac_limbs -= shift;
+    } else if (limb_shift < 0) {
+        // Точка переносится вверх; целой части нужен хотя бы один лимб
+        size_t shift = static_cast<size_t>(-limb_shift);
+        if (length < frac_limbs + shift + 1) {
+            extend_integer(frac_limbs + shift + 1 - length);
+        }
+        frac_limbs += shift;
+    }
+    if (frac_limbs == 0) {
+        extend_fraction(1);
+    }
+
+    normalize();
+    return *this;
+}
+
 // Деление с остатком (возвращает пару: частное и остаток)
 std::pair<FixedPoint, FixedPoint> FixedPoint::divide_with_remainder(const FixedPoint &other) const {
     if (other.is_zero()) {
@@ -994,7 +1382,7 @@ std::pair<FixedPoint, FixedPoint> FixedPoint::divide_with_remainder(const FixedP
     // Корректируем знак остатка (должен совпадать с делимым)
     remainder.is_negative = this->is_negative;
     
-    return {quotient, remainder};
+    return {std::move(quotient), std::move(remainder)};
 }
 
 // Побитовый XOR 
@@ -1007,11 +1395,11 @@ FixedPoint FixedPoint::operator^(const FixedPoint &other) const {
     b.set_precision(max_frac_bits);
     
     // Собираем все биты (целые + дробные) в один вектор
-    std::vector<uint32_t> bits_a = a.integer;
-    bits_a.insert(bits_a.end(), a.fractional.begin(), a.fractional.end());
+    std::vector<uint32_t> bits_a(a.int_data(), a.int_data() + a.int_size());
+    bits_a.insert(bits_a.end(), a.limb_data(), a.limb_data() + a.frac_limbs);
     
-    std::vector<uint32_t> bits_b = b.integer;
-    bits_b.insert(bits_b.end(), b.fractional.begin(), b.fractional.end());
+    std::vector<uint32_t> bits_b(b.int_data(), b.int_data() + b.int_size());
+    bits_b.insert(bits_b.end(), b.limb_data(), b.limb_data() + b.frac_limbs);
     
     // Выполняем XOR
     size_t max_size = std::max(bits_a.size(), bits_b.size());
@@ -1024,9 +1412,9 @@ FixedPoint FixedPoint::operator^(const FixedPoint &other) const {
     
     // Разделяем обратно на целую и дробную части
     FixedPoint result("0.0", max_frac_bits);
-    size_t int_size = a.integer.size();
-    result.integer.assign(result_bits.begin(), result_bits.begin() + int_size);
-    result.fractional.assign(result_bits.begin() + int_size, result_bits.end());
+    size_t int_size = a.int_size();
+    result.assign_parts(std::vector<uint32_t>(result_bits.begin(), result_bits.begin() + int_size),
+                        std::vector<uint32_t>(result_bits.begin() + int_size, result_bits.end()));
     
     return result;
 }
@@ -1034,8 +1422,7 @@ FixedPoint FixedPoint::operator^(const FixedPoint &other) const {
 
 // Определяемый пользователем оператор литерала для создания объектов с фиксированной точкой
 FixedPoint operator""_long(long double number) {
-    return FixedPoint(std::to_string(number), 64); 
-
+    return FixedPoint(number, 64);
 }
 
 
@@ -1,20 +1,25 @@
 #include "../include/long_arithmetic.hpp"
 #include "../include/pi_calculation.hpp"
+#include "../include/limb_buffer.hpp"
 
 void CalcPi(FixedPoint &pi, const int k_start, const int k_finish, const FixedPoint &bs) {
-    FixedPoint one = FixedPoint(1.0, 256);
-    FixedPoint two = FixedPoint(2.0, 256);
-    FixedPoint four = FixedPoint(4.0, 256);
+    // Деление на целое сохраняет дробную часть делимого, а деление на
+    // FixedPoint(x, 256) добавляло к ней ещё 256 бит - отсюда 512 бит
+    FixedPoint one = FixedPoint(1.0, 512);
+    FixedPoint two = FixedPoint(2.0, 512);
+    FixedPoint four = FixedPoint(4.0, 512);
     FixedPoint base = bs;
     FixedPoint res = FixedPoint(0.0, 256);
     for(int i = k_start; i < k_finish; ++i) {
-        res = res + ((four / FixedPoint(8 * i + 1, 256)) -
-                     (two / FixedPoint(8 * i + 4, 256)) -
-                     (one / FixedPoint(8 * i + 5, 256)) -
-                     (one / FixedPoint(8 * i + 6, 256))) / base;
-        base = base * FixedPoint(16.0, 256);
+        FixedPoint term = four / (8 * i + 1);
+        term -= two / (8 * i + 4);
+        term -= one / (8 * i + 5);
+        term -= one / (8 * i + 6);
+        term /= base;
+        res += term;
+        base.scale_by_pow2(4);
     }
-    pi = pi + res;
+    pi += res;
 }
 
 FixedPoint get_pi() {
@@ -22,12 +27,17 @@ FixedPoint get_pi() {
     int n = (prec + 15) / 16 * 16;
     int signs = n / 16;
     FixedPoint pi = FixedPoint(0.0, 256);
+
+    // Промежуточные числа берут память из арены, она освобождается целиком
+    // при выходе; pi создан до области и хранит лимбы в обычной куче
+    LimbArena arena;
+    LimbResourceScope scope(&arena);
     FixedPoint curBs = FixedPoint(1.0, 256);
 
     for (int i = 0; i <= n; i++) {
         if (i % signs == 0)
             CalcPi(pi, i, i + signs, curBs);
-        curBs = curBs * FixedPoint(16.0, 256);
+        curBs.scale_by_pow2(4);
     }
     return pi;
 }
\ No newline at end of file
@@ -1,8 +1,16 @@
 #include <gtest/gtest.h>
 #include <chrono>
 #include <vector>
+#include <random>
+#include <limits>
+#include <cstdint>
+#include <sstream>
 
 #include "../include/long_arithmetic.hpp"
+#include "../include/limb_kernels.hpp"
+#include "../include/limb_buffer.hpp"
+#include "../include/fixed_point_divisor.hpp"
+#include "../include/static_fixed_point.hpp"
 #include "../include/pi_calculation.hpp"
 
 
@@ -20,6 +28,39 @@ TEST_F(FixedPointTest, Constructor) {
     EXPECT_EQ(num.to_string(3), "123.456");
 }
 
+/**
+ * @test Тест округления при выводе
+ * @brief to_string(len) округляет дробь половиной вверх с переносом через девятки
+ */
+TEST_F(FixedPointTest, ToStringRounding) {
+    EXPECT_EQ(FixedPoint("2.06049549", 64).to_string(5), "2.06050");
+    EXPECT_EQ(FixedPoint("-0.96", 64).to_string(1), "-1.0");
+    EXPECT_EQ(FixedPoint("99.99609375", 64).to_string(2), "100.00");
+    EXPECT_EQ(FixedPoint("2.4", 64).to_string(0), "2.0");
+    EXPECT_EQ(FixedPoint("0.75", 64).to_string(5), "0.75");
+    EXPECT_EQ(FixedPoint("123.456", 64).to_string(), "123.4559999999999999");
+    EXPECT_EQ(get_pi().to_string(30), "3.141592653589793238462643383280");
+}
+
+/**
+ * @test Тест потокового вывода
+ * @brief write_digits выводит то же, что to_string, а без округления - усечённые цифры
+ */
+TEST_F(FixedPointTest, WriteDigits) {
+    for (const char *str : {"2.06049549", "-0.96", "99.99609375", "0.0", "-12345678901234567890.5"}) {
+        FixedPoint value(str, 64);
+        for (int len : {-1, 0, 2, 5, 30}) {
+            std::ostringstream out;
+            value.write_digits(out, len);
+            EXPECT_EQ(out.str(), value.to_string(len)) << str << " " << len;
+        }
+    }
+
+    std::string truncated;
+    FixedPoint("99.99609375", 64).write_digits([&](const char *data, size_t n) { truncated.append(data, n); }, 2, false);
+    EXPECT_EQ(truncated, "99.99");
+}
+
 /**
  * @test Тест операции сложения
  * @brief Проверка корректности работы оператора +
@@ -42,6 +83,25 @@ TEST_F(FixedPointTest, Subtraction) {
     EXPECT_EQ(result.to_string(), "30.75");
 }
 
+/**
+ * @test Тест сложения и вычитания многолимбовых чисел
+ * @brief Переносы и заёмы между лимбами и между дробной и целой частью
+ * @details Операнды с разным числом лимбов в целой и дробной частях: у одного
+ * длиннее целая часть, у другого - дробная.
+ */
+TEST_F(FixedPointTest, MultiLimbAddSub) {
+    EXPECT_EQ((FixedPoint("4294967295.75", 32) + FixedPoint("0.25", 32)).to_string(), "4294967296.0");
+    EXPECT_EQ((FixedPoint("4294967296.0", 32) - FixedPoint("0.5", 64)).to_string(), "4294967295.5");
+
+    FixedPoint wide_int("1099511627776.5", 32), wide_frac("0.25", 96);
+    FixedPoint neg_wide_frac("-0.25", 96);
+    EXPECT_EQ((wide_int + neg_wide_frac).to_string(), "1099511627776.25");
+    EXPECT_EQ((neg_wide_frac + wide_int).to_string(), "1099511627776.25");
+    EXPECT_EQ((wide_int - wide_frac).to_string(), "1099511627776.25");
+    EXPECT_EQ((wide_frac - wide_int).to_string(), "-1099511627776.25");
+    EXPECT_EQ((wide_int + wide_frac).to_string(), "1099511627776.75");
+}
+
 /**
  * @test Тест операции умножения
  * @brief Проверка корректности работы оператора *
@@ -53,6 +113,464 @@ TEST_F(FixedPointTest, Multiplication) {
     EXPECT_EQ(result.to_string(), "21.0");
 }
 
+/**
+ * @test Тест умножения многолимбовых чисел
+ * @brief Проверка переносов между лимбами при умножении
+ */
+TEST_F(FixedPointTest, MultiLimbMultiplication) {
+    FixedPoint a("4294967295");
+    EXPECT_EQ((a * a).to_string(), "18446744065119617025.0");
+
+    FixedPoint b("12345678901234567890.5");
+    FixedPoint c("98765432109876543210.25");
+    EXPECT_EQ((b * c).to_string(), "1219326311370217952289932936891510440477.625");
+
+    FixedPoint d("-340282366920938463463374607431768211455.75");
+    FixedPoint e("18446744073709551617.5");
+    EXPECT_EQ((d * e).to_string(), "-6277101735386680764346212973589074111292805669593259442175.625");
+}
+
+/**
+ * @test Тест алгоритмов умножения лимбовых массивов
+ * @brief Карацуба, Тоом-3, Тоом-4 и общий выбор алгоритма совпадают со столбиком
+ * @details Проверяет:
+ * - Сбалансированные операнды вокруг порогов переключения
+ * - Несбалансированные операнды и операнды из одних единичных битов
+ */
+TEST(LimbKernelsTests, MultiplicationTiers) {
+    std::mt19937 rng(7);
+    auto check = [&](size_t an, size_t bn, bool all_ones) {
+        std::vector<uint32_t> a(an), b(bn);
+        for (auto &x : a) x = all_ones ? 0xFFFFFFFF : rng();
+        for (auto &x : b) x = all_ones ? 0xFFFFFFFF : rng();
+
+        std::vector<uint32_t> expected(an + bn), got(an + bn);
+        limbs::mul_basecase(expected.data(), a.data(), an, b.data(), bn);
+
+        limbs::mul(got.data(), a.data(), an, b.data(), bn);
+        EXPECT_EQ(got, expected) << "mul " << an << "x" << bn;
+
+        if (an >= bn && bn > (an + 1) / 2) {
+            limbs::mul_karatsuba(got.data(), a.data(), an, b.data(), bn);
+            EXPECT_EQ(got, expected) << "karatsuba " << an << "x" << bn;
+            limbs::mul_toom3(got.data(), a.data(), an, b.data(), bn);
+            EXPECT_EQ(got, expected) << "toom3 " << an << "x" << bn;
+            limbs::mul_toom4(got.data(), a.data(), an, b.data(), bn);
+            EXPECT_EQ(got, expected) << "toom4 " << an << "x" << bn;
+        }
+    };
+
+    for (size_t n : {2, 7, 39, 40, 41, 65, 161, 399, 777, 799, 800, 801}) {
+        check(n, n, false);
+        check(n, n, true);
+        check(n + n / 3, n, false);
+    }
+    check(1000, 40, false);
+    check(5000, 450, true);
+    check(2500, 2400, false);
+}
+
+/**
+ * @test Тест умножения через NTT
+ * @brief Свёртка по трём модулям совпадает с точным произведением
+ * @details Проверяет:
+ * - Операнды из одних единичных битов (наибольшие коэффициенты свёртки)
+ * - Несбалансированные операнды и длины, не равные степени двойки
+ */
+TEST(LimbKernelsTests, NttMultiplication) {
+    std::mt19937 rng(11);
+    auto check = [&](size_t an, size_t bn, bool all_ones) {
+        std::vector<uint32_t> a(an), b(bn);
+        for (auto &x : a) x = all_ones ? 0xFFFFFFFF : rng();
+        for (auto &x : b) x = all_ones ? 0xFFFFFFFF : rng();
+
+        std::vector<uint32_t> expected(an + bn), got(an + bn);
+        limbs::mul_karatsuba(expected.data(), a.data(), an, b.data(), bn);
+        limbs::mul_ntt(got.data(), a.data(), an, b.data(), bn);
+        EXPECT_EQ(got, expected) << "ntt " << an << "x" << bn;
+    };
+
+    check(2, 2, true);
+    check(100, 99, false);
+    check(4096, 4096, true);
+    check(9000, 8001, false);
+    check(3000, 2000, true);
+}
+
+/**
+ * @test Тест алгоритмов возведения в квадрат
+ * @brief Все уровни limbs::sqr совпадают с умножением столбиком
+ */
+TEST(LimbKernelsTests, Squaring) {
+    std::mt19937 rng(13);
+    for (size_t n : {1, 2, 5, 63, 64, 65, 300, 801, 2401, 8001}) {
+        for (bool all_ones : {false, true}) {
+            std::vector<uint32_t> a(n);
+            for (auto &x : a) x = all_ones ? 0xFFFFFFFF : rng();
+
+            std::vector<uint32_t> expected(2 * n), got(2 * n);
+            limbs::mul_basecase(expected.data(), a.data(), n, a.data(), n);
+
+            limbs::sqr(got.data(), a.data(), n);
+            EXPECT_EQ(got, expected) << "sqr " << n;
+            if (n <= 2400) {
+                limbs::sqr_basecase(got.data(), a.data(), n);
+                EXPECT_EQ(got, expected) << "sqr_basecase " << n;
+            }
+            if (n >= 2) {
+                limbs::sqr_karatsuba(got.data(), a.data(), n);
+                EXPECT_EQ(got, expected) << "sqr_karatsuba " << n;
+                limbs::sqr_toom3(got.data(), a.data(), n);
+                EXPECT_EQ(got, expected) << "sqr_toom3 " << n;
+                limbs::sqr_toom4(got.data(), a.data(), n);
+                EXPECT_EQ(got, expected) << "sqr_toom4 " << n;
+                limbs::sqr_ntt(got.data(), a.data(), n);
+                EXPECT_EQ(got, expected) << "sqr_ntt " << n;
+            }
+        }
+    }
+}
+
+/**
+ * @test Тест деления лимбовых массивов
+ * @brief Частное и остаток limbs::divrem удовлетворяют a = q * d + r, r < d
+ * @details Проверяет:
+ * - Однолимбовые и многолимбовые делители, делители без сдвига нормализации
+ * - Операнды, на которых оценка цифры частного требует исправления
+ * - Рекурсивное деление Буркинеля - Циглера и умножение на обратное
+ */
+TEST(LimbKernelsTests, Division) {
+    std::mt19937 rng(17);
+    auto check = [&](std::vector<uint32_t> a, std::vector<uint32_t> d) {
+        size_t an = a.size(), dn = d.size();
+        std::vector<uint32_t> q(an - dn + 1), r(dn);
+        limbs::divrem(q.data(), r.data(), a.data(), an, d.data(), dn);
+
+        std::vector<uint32_t> back(an + 1, 0);
+        limbs::mul(back.data(), q.data(), q.size(), d.data(), dn);
+        limbs::add(back.data(), back.data(), back.size(), r.data(), dn);
+        back.pop_back();
+        EXPECT_EQ(back, a) << an << "/" << dn;
+        EXPECT_LT(limbs::cmp(r.data(), d.data(), dn), 0) << an << "/" << dn;
+    };
+    auto random = [&](size_t n) {
+        std::vector<uint32_t> v(n);
+        for (auto &x : v) x = rng();
+        if (v.back() == 0) v.back() = 1;
+        return v;
+    };
+
+    for (size_t dn : {1, 2, 3, 17, 100}) {
+        for (size_t an : {dn, dn + 1, 2 * dn + 5, 3 * dn + 40}) {
+            check(random(an), random(dn));
+        }
+    }
+
+    std::vector<uint32_t> top_set = random(5);
+    top_set.back() = 0x80000000;
+    check(random(12), top_set);
+    check(std::vector<uint32_t>(9, 0xFFFFFFFF), {0xFFFFFFFF, 0x80000000});
+    check({0, 0, 0, 0x7FFFFFFF, 0x80000000}, {1, 0, 0x80000000});
+
+    // Рекурсивное деление: полные и неполные блоки частного, несколько уровней рекурсии
+    for (size_t dn : {limbs::DIV_BZ_THRESHOLD, limbs::DIV_BZ_THRESHOLD + 7, 5 * limbs::DIV_BZ_THRESHOLD + 3}) {
+        check(random(2 * dn), random(dn));
+        check(random(3 * dn + 2 * limbs::DIV_BZ_THRESHOLD + 1), random(dn));
+        check(std::vector<uint32_t>(3 * dn, 0xFFFFFFFF), std::vector<uint32_t>(dn, 0xFFFFFFFF));
+    }
+
+    // Умножение на обратное вызывается напрямую: через divrem оно выбирается лишь на огромных длинах
+    auto check_kernel = [&](size_t an, size_t dn, bool preinv) {
+        std::vector<uint32_t> a = random(an), d = random(dn);
+        d.back() |= 0x80000000;
+        a.back() &= 0x7FFFFFFF;
+        std::vector<uint32_t> u = a, q(an - dn), x(dn + 1);
+        if (preinv) {
+            limbs::invert(x.data(), d.data(), dn);
+            limbs::div_preinv(q.data(), u.data(), an, d.data(), dn, x.data());
+        } else {
+            limbs::div_newton(q.data(), u.data(), an, d.data(), dn);
+        }
+
+        std::vector<uint32_t> back(an + 1, 0);
+        limbs::mul(back.data(), q.data(), q.size(), d.data(), dn);
+        limbs::add(back.data(), back.data(), back.size(), u.data(), dn);
+        back.pop_back();
+        EXPECT_EQ(back, a) << an << "/" << dn << (preinv ? " preinv" : " newton");
+        EXPECT_LT(limbs::cmp(u.data(), d.data(), dn), 0) << an << "/" << dn;
+    };
+    for (size_t dn : {size_t(300), size_t(307)}) {
+        for (bool preinv : {false, true}) {
+            check_kernel(2 * dn, dn, preinv);
+            check_kernel(3 * dn + 123, dn, preinv);
+        }
+    }
+}
+
+/**
+ * @test Тест обратного числа для лимбовых массивов
+ * @brief limbs::invert даёт floor(B^(2n) / v) для длин по обе стороны порога Ньютона
+ */
+TEST(LimbKernelsTests, Invert) {
+    std::mt19937 rng(19);
+    for (size_t n : {size_t(1), size_t(2), size_t(9), limbs::INV_NEWTON_THRESHOLD + 1, 3 * limbs::INV_NEWTON_THRESHOLD + 5}) {
+        for (int kind = 0; kind < 3; ++kind) {
+            std::vector<uint32_t> v(n);
+            for (auto &x : v) x = kind == 0 ? rng() : (kind == 1 ? 0 : 0xFFFFFFFF);
+            v.back() |= 0x80000000;
+
+            std::vector<uint32_t> x(n + 1), expected(n + 2), u(2 * n + 1, 0);
+            u[2 * n] = 1;
+            limbs::invert(x.data(), v.data(), n);
+            limbs::divrem(expected.data(), nullptr, u.data(), u.size(), v.data(), n);
+            expected.resize(n + 1);
+            EXPECT_EQ(x, expected) << "invert " << n << " kind " << kind;
+        }
+    }
+}
+
+/**
+ * @test Тест перевода десятичной строки в лимбы
+ * @brief limbs::set_str совпадает с переводом по одной цифре (r = r * 10 + цифра)
+ * @details Длины по обе стороны порога деления пополам и на границах
+ * блоков 9 * 2^k, строки с ведущими нулями и из одних девяток.
+ */
+TEST(LimbKernelsTests, DecimalParsing) {
+    std::mt19937 rng(21);
+    const size_t t = limbs::SET_STR_DC_THRESHOLD;
+    for (size_t n : {size_t(1), size_t(9), size_t(10), t - 1, t, 9 * size_t(256), 9 * size_t(256) + 1, 3 * t + 7}) {
+        for (int kind = 0; kind < 3; ++kind) {
+            std::string digits(n, '9');
+            if (kind != 2) {
+                for (char &c : digits) c = static_cast<char>('0' + rng() % 10);
+            }
+            if (kind == 1) digits.replace(0, n / 2, n / 2, '0');
+
+            std::vector<uint32_t> expected;
+            for (char c : digits) {
+                uint32_t carry = limbs::mul_1(expected.data(), expected.data(), expected.size(), 10);
+                if (carry != 0) expected.push_back(carry);
+                carry = limbs::add_1(expected.data(), expected.data(), expected.size(), static_cast<uint32_t>(c - '0'));
+                if (carry != 0) expected.push_back(carry);
+            }
+
+            std::vector<uint32_t> r(limbs::set_str_limbs(n));
+            r.resize(limbs::set_str(r.data(), digits.data(), n));
+            EXPECT_EQ(r, expected) << "set_str " << n << " kind " << kind;
+        }
+    }
+}
+
+/**
+ * @test Тест перевода лимбов в десятичную строку
+ * @brief limbs::get_str обратен limbs::set_str, limbs::frac_digits усекает или округляет дробь
+ * @details Длины по обе стороны порога деления пополам; дроби, у которых
+ * отброшенные младшие лимбы меняют последнюю цифру.
+ */
+TEST(LimbKernelsTests, DecimalOutput) {
+    std::mt19937 rng(23);
+    const size_t t = limbs::GET_STR_DC_THRESHOLD;
+    for (size_t n : {size_t(1), t - 1, t, 3 * t + 5, 40 * t}) {
+        std::vector<uint32_t> a(n);
+        for (auto &x : a) x = rng();
+        std::string digits(limbs::get_str_digits(n), ' ');
+        digits.resize(limbs::get_str(&digits[0], a.data(), n));
+        ASSERT_FALSE(digits.empty());
+        EXPECT_NE(digits[0], '0');
+
+        std::vector<uint32_t> back(limbs::set_str_limbs(digits.size()));
+        back.resize(limbs::set_str(back.data(), digits.data(), digits.size()));
+        EXPECT_EQ(back, a) << "get_str " << n;
+    }
+
+    // 0.1 с недостатком и с избытком в 8 лимбах
+    std::vector<uint32_t> below(8, 0x99999999), above(8, 0x99999999);
+    below[7] = above[7] = 0x19999999;
+    above[0] = 0x9999999A;
+    std::vector<uint32_t> r(limbs::frac_digits_limbs(20));
+    char out[20];
+    EXPECT_FALSE(limbs::frac_digits(r.data(), 20, below.data(), 8, false));
+    limbs::get_str_padded(out, 20, r.data(), r.size());
+    EXPECT_EQ(std::string(out, 20), "09999999999999999999");
+    EXPECT_FALSE(limbs::frac_digits(r.data(), 1, above.data(), 8, false));
+    limbs::get_str_padded(out, 1, r.data(), r.size());
+    EXPECT_EQ(out[0], '1');
+
+    // Округление 0.0999... до 19 цифр переносит единицу в первую цифру,
+    // до 20 - доходит до целой части у 0.999...
+    EXPECT_FALSE(limbs::frac_digits(r.data(), 19, below.data(), 8, true));
+    limbs::get_str_padded(out, 19, r.data(), r.size());
+    EXPECT_EQ(std::string(out, 19), "1000000000000000000");
+    std::vector<uint32_t> nines(8, 0xFFFFFFFF);
+    EXPECT_TRUE(limbs::frac_digits(r.data(), 20, nines.data(), 8, true));
+    EXPECT_EQ(limbs::normalized_size(r.data(), r.size()), 0u);
+
+    std::vector<uint32_t> quarter = {0, 0x40000000};
+    EXPECT_FALSE(limbs::frac_digits(r.data(), 3, quarter.data(), 2, true));
+    limbs::get_str_padded(out, 3, r.data(), r.size());
+    EXPECT_EQ(std::string(out, 3), "250");
+
+    // Блоки write_str в сумме дают то же, что get_str
+    std::vector<uint32_t> big(200 * t);
+    for (auto &x : big) x = rng();
+    std::string whole(limbs::get_str_digits(big.size()), ' ');
+    whole.resize(limbs::get_str(&whole[0], big.data(), big.size()));
+    std::string streamed;
+    size_t blocks = 0;
+    limbs::write_str([&](const char *data, size_t n) {
+        EXPECT_LE(n, limbs::DIGIT_BLOCK_SIZE);
+        streamed.append(data, n);
+        blocks++;
+    }, big.data(), big.size());
+    EXPECT_EQ(streamed, whole);
+    EXPECT_EQ(blocks, (whole.size() + limbs::DIGIT_BLOCK_SIZE - 1) / limbs::DIGIT_BLOCK_SIZE);
+    EXPECT_EQ(limbs::decimal_digits(big.data(), big.size()), whole.size());
+
+    // decimal_digits на границах степеней десяти, в том числе в машинных словах
+    std::vector<uint32_t> small = {9, 0};
+    EXPECT_EQ(limbs::decimal_digits(small.data(), 2), 1u);
+    small = {0x89E80000, 0x8AC72304}; // 10^19
+    EXPECT_EQ(limbs::decimal_digits(small.data(), 2), 20u);
+    small = {0x89E7FFFF, 0x8AC72304};
+    EXPECT_EQ(limbs::decimal_digits(small.data(), 2), 19u);
+    for (size_t k : {size_t(30), size_t(100), size_t(1000)}) {
+        std::string power = "1" + std::string(k, '0');
+        std::vector<uint32_t> p(limbs::set_str_limbs(power.size()));
+        p.resize(limbs::set_str(p.data(), power.data(), power.size()));
+        EXPECT_EQ(limbs::decimal_digits(p.data(), p.size()), k + 1);
+        limbs::sub_1(p.data(), p.data(), p.size(), 1);
+        EXPECT_EQ(limbs::decimal_digits(p.data(), p.size()), k);
+    }
+}
+
+/**
+ * @test Тест буфера лимбов
+ * @brief Короткий буфер хранится внутри объекта, длинный переносится в кучу без потери данных
+ * @details Проверяются рост через push_back и insert_zeros, а также копирование
+ * и перемещение встроенного и вынесенного в кучу буфера.
+ */
+TEST(LimbBufferTests, InlineAndHeapStorage) {
+    LimbBuffer buf(3);
+    EXPECT_TRUE(buf.is_inline());
+    EXPECT_EQ(buf[0] | buf[1] | buf[2], 0u);
+
+    for (uint32_t i = 0; i < LimbBuffer::INLINE_LIMBS - 3; ++i) buf.push_back(i + 1);
+    EXPECT_TRUE(buf.is_inline());
+    buf.insert_zeros(2);
+    EXPECT_FALSE(buf.is_inline());
+    ASSERT_EQ(buf.size(), LimbBuffer::INLINE_LIMBS + 2);
+    EXPECT_EQ(buf[0] | buf[1] | buf[2] | buf[3] | buf[4], 0u);
+    EXPECT_EQ(buf.back(), LimbBuffer::INLINE_LIMBS - 3);
+
+    LimbBuffer heap_copy = buf;
+    LimbBuffer heap_moved = std::move(buf);
+    EXPECT_TRUE(std::equal(heap_copy.begin(), heap_copy.end(), heap_moved.begin(), heap_moved.end()));
+    EXPECT_TRUE(buf.empty());
+
+    LimbBuffer small(heap_copy.begin(), heap_copy.begin() + 4);
+    heap_moved = std::move(small);
+    EXPECT_EQ(heap_moved.size(), 4u);
+    EXPECT_EQ(heap_moved[3], 0u);
+    heap_moved.resize(40);
+    EXPECT_EQ(heap_moved[39], 0u);
+}
+
+/**
+ * @brief Ресурс памяти, считающий выделения и ещё не возвращённые байты
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t live_bytes = 0;
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        live_bytes += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+        live_bytes -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+/**
+ * @test Тест ресурсов памяти для лимбов
+ * @brief Числа внутри LimbResourceScope берут память из ресурса области и возвращают её туда же
+ * @details Число, созданное до области, продолжает пользоваться своим ресурсом,
+ * в том числе при присваивании результатов из области. Арена и пул потока
+ * дают те же значения, что и обычная куча.
+ */
+TEST(LimbBufferTests, MemoryResources) {
+    FixedPoint a("3.14159265358979323846", 1024), b("-2.71828182845904523536", 1024);
+    FixedPoint outside = a;
+    CountingResource counting;
+    {
+        LimbResourceScope scope(&counting);
+        EXPECT_EQ(limb_resource(), &counting);
+        FixedPoint product = a * b;
+        EXPECT_GT(counting.allocations, 0u);
+        outside = product + a;
+        EXPECT_EQ(outside.to_string(), (a * b + a).to_string());
+    }
+    EXPECT_EQ(limb_resource(), std::pmr::new_delete_resource());
+    EXPECT_EQ(counting.live_bytes, 0u);
+
+    std::string expected = (a * b - a / b).to_string();
+    {
+        LimbArena arena;
+        LimbResourceScope scope(&arena);
+        EXPECT_EQ((a * b - a / b).to_string(), expected);
+        {
+            LimbResourceScope pool_scope(limb_pool());
+            EXPECT_EQ((a * b - a / b).to_string(), expected);
+        }
+        EXPECT_EQ(limb_resource(), &arena);
+    }
+    std::string pi_str = get_pi().to_string();
+    pi_str.resize(pi_right.size());
+    EXPECT_EQ(pi_str, pi_right);
+}
+
+/**
+ * @test Тест временной памяти умножения
+ * @brief Тоом-3, Тоом-4 и NTT берут временные лимбы из ресурса области и возвращают их
+ */
+TEST(LimbBufferTests, MultiplicationTemporaries) {
+    std::mt19937 rng(25);
+    for (size_t n : {limbs::TOOM3_THRESHOLD, limbs::TOOM4_THRESHOLD, limbs::NTT_THRESHOLD}) {
+        std::vector<uint32_t> a(n), b(n), expected(2 * n), got(2 * n);
+        for (auto &x : a) x = rng();
+        for (auto &x : b) x = rng();
+        limbs::mul(expected.data(), a.data(), n, b.data(), n);
+
+        CountingResource counting;
+        {
+            LimbResourceScope scope(&counting);
+            limbs::mul(got.data(), a.data(), n, b.data(), n);
+        }
+        EXPECT_EQ(got, expected) << n;
+        EXPECT_GT(counting.allocations, 0u) << n;
+        EXPECT_EQ(counting.live_bytes, 0u) << n;
+    }
+}
+
+/**
+ * @test Тест возведения FixedPoint в квадрат
+ * @brief square() и a * a совпадают с умножением на копию
+ */
+TEST_F(FixedPointTest, Square) {
+    FixedPoint a("-12345678901234567890.0625", 96);
+    FixedPoint copy = a;
+    EXPECT_EQ(a.square().to_string(), (a * copy).to_string());
+    EXPECT_EQ((a * a).to_string(), (a * copy).to_string());
+    EXPECT_EQ(a.square().to_string(), "152415787532388367503448409737673373086.25390625");
+}
+
 /**
  * @test Тест операции деления
  * @brief Проверка корректности работы оператора /
@@ -64,6 +582,282 @@ TEST_F(FixedPointTest, Division) {
     EXPECT_EQ(result.to_string(), "10.5");
 }
 
+/**
+ * @test Тест обратного числа
+ * @brief reciprocal() усекает 1 / x до заданного числа бит
+ * @details Проверяет:
+ * - Числа больше и меньше единицы, отрицательные числа
+ * - Согласованность с делением единицы на число
+ */
+TEST_F(FixedPointTest, Reciprocal) {
+    EXPECT_EQ(FixedPoint("3").reciprocal(64).to_string(), "0.3333333333333333");
+    EXPECT_EQ(FixedPoint("-0.125", 32).reciprocal(8).to_string(), "-8.0");
+    EXPECT_EQ(FixedPoint("0.75", 32).reciprocal(3).to_string(), "1.25");
+
+    FixedPoint big("12345678901234567890123456789.0625", 128);
+    FixedPoint one("1", 1024);
+    EXPECT_EQ(big.reciprocal(1024 + 128).to_string(), (one / big).to_string());
+    EXPECT_THROW(FixedPoint("0.0").reciprocal(32), std::runtime_error);
+}
+
+/**
+ * @test Тест делителя с заранее вычисленным обратным
+ * @brief FixedPointDivisor совпадает с operator/ и divide_with_remainder
+ * @details Проверяет:
+ * - Однолимбовый делитель (Мёллер - Гранлунд) и многолимбовые делители
+ *   по обе стороны порога редукции Барретта
+ * - Дробные и отрицательные делимые и делители
+ */
+TEST_F(FixedPointTest, PrecomputedDivisor) {
+    std::mt19937 rng(23);
+    auto random_number = [&](size_t digits, int frac_bits) {
+        std::string s = rng() % 2 ? "-" : "";
+        s += std::to_string(rng() % 9 + 1);
+        for (size_t i = 1; i < digits; ++i) s += std::to_string(rng() % 10);
+        s += "." + std::to_string(rng());
+        return FixedPoint(s, frac_bits);
+    };
+
+    // Длинные числа (сотни лимбов) строятся возведением в квадрат, а не разбором строки
+    auto power = [](FixedPoint x, int squarings) {
+        for (int i = 0; i < squarings; ++i) x = x.square();
+        return x;
+    };
+    FixedPoint zero(0.0);
+
+    std::vector<FixedPoint> divisors = {FixedPoint("10", 0), FixedPoint("-3.5", 32), random_number(30, 64),
+                                        power(random_number(80, 64), 5)};
+    for (const FixedPoint &d : divisors) {
+        FixedPointDivisor divisor(d);
+        for (const FixedPoint &a : {random_number(1, 96), random_number(40, 96),
+                                    power(random_number(90, 32), 6) * random_number(5, 32)}) {
+            FixedPoint q_div = divisor.divide(a);
+            FixedPoint q_div_ref = a / d;
+            EXPECT_TRUE(q_div == q_div_ref);
+            EXPECT_EQ(q_div < zero, q_div_ref < zero);
+
+            auto [q, r] = divisor.divmod(a);
+            auto [q_ref, r_ref] = a.divide_with_remainder(d);
+            EXPECT_TRUE(q == q_ref);
+            EXPECT_TRUE(r == r_ref);
+            EXPECT_EQ(r < zero, r_ref < zero);
+        }
+    }
+    FixedPoint small("-1234567.890625", 32);
+    EXPECT_EQ(FixedPointDivisor(FixedPoint("10", 0)).divide(small).to_string(), "-123456.7890625");
+    EXPECT_THROW(FixedPointDivisor(FixedPoint("0.0")), std::runtime_error);
+}
+
+/**
+ * @test Тест арифметики с машинными целыми
+ * @brief Операции с int64_t и uint64_t совпадают с операциями над FixedPoint(value)
+ * @details Проверяет:
+ * - Однолимбовые и двухлимбовые значения, смену знака при сложении
+ * - Деление с остатком и деление на ноль
+ */
+TEST_F(FixedPointTest, ScalarArithmetic) {
+    FixedPoint a("-98765432109876543210.3125", 64);
+    FixedPoint small("7.75", 32);
+
+    for (int64_t v : {int64_t(0), int64_t(3), int64_t(-10), int64_t(4294967296), int64_t(-99999999999999999)}) {
+        FixedPoint fv(std::to_string(v), 0);
+        FixedPoint fv_wide(std::to_string(v), 64);
+        for (const FixedPoint &x : {a, small}) {
+            EXPECT_EQ((x + v).to_string(), (x + fv_wide).to_string()) << v;
+            EXPECT_EQ((x - v).to_string(), (x - fv_wide).to_string()) << v;
+            EXPECT_EQ((x * v).to_string(), (x * fv).to_string()) << v;
+            if (v != 0) {
+                EXPECT_EQ((x / v).to_string(), (x / fv).to_string()) << v;
+            }
+        }
+    }
+
+    uint64_t big = 18446744073709551615u;
+    EXPECT_EQ((small * big).to_string(), "142962266571249025016.25");
+    EXPECT_EQ((small - big).to_string(), "-18446744073709551607.25");
+
+    auto [q, r] = a.divide_with_remainder(1000000007u);
+    EXPECT_EQ(q.to_string(), "-98765431418.0");
+    EXPECT_EQ(r.to_string(), "-518523284.3125");
+    EXPECT_THROW(a / 0, std::runtime_error);
+}
+
+/**
+ * @test Тест составных операторов присваивания
+ * @brief +=, -=, *=, /= дают то же, что и соответствующие бинарные операторы
+ * @details Проверяет смену знака при вычитании большего модуля, рост длины
+ * целой и дробной частей и операнд, совпадающий с *this.
+ */
+TEST_F(FixedPointTest, CompoundAssignment) {
+    const FixedPoint values[] = {FixedPoint("4294967295.75", 32), FixedPoint("-0.000244140625", 96),
+                                 FixedPoint("-18446744073709551616.5", 64), FixedPoint("3.0", 32)};
+    for (const FixedPoint &a : values) {
+        for (const FixedPoint &b : values) {
+            FixedPoint x = a;
+            x += b;
+            EXPECT_EQ(x.to_string(), (a + b).to_string());
+            x = a;
+            x -= b;
+            EXPECT_EQ(x.to_string(), (a - b).to_string());
+            x = a;
+            x *= b;
+            EXPECT_EQ(x.to_string(), (a * b).to_string());
+            x = a;
+            x /= b;
+            EXPECT_EQ(x.to_string(), (a / b).to_string());
+        }
+    }
+
+    FixedPoint x("-1.5", 32);
+    x += x;
+    EXPECT_EQ(x.to_string(), "-3.0");
+    x *= x;
+    EXPECT_EQ(x.to_string(), "9.0");
+    x /= x;
+    EXPECT_EQ(x.to_string(), "1.0");
+    x -= x;
+    EXPECT_EQ(x.to_string(), "0.0");
+
+    FixedPoint acc("1.25", 32);
+    acc -= FixedPoint("2.5", 32);
+    EXPECT_EQ(acc.to_string(), "-1.25");
+    acc -= FixedPoint("-1.25", 32);
+    EXPECT_TRUE(acc == FixedPoint("0.0", 32));
+}
+
+/**
+ * @test Тест операторов с временными операндами
+ * @brief Перегрузки для rvalue дают тот же результат и знак, что и для lvalue
+ * @details Включает равные модули, где знак нулевого результата берётся от
+ * левого операнда.
+ */
+TEST_F(FixedPointTest, RvalueOperators) {
+    const FixedPoint values[] = {FixedPoint("7.5", 32), FixedPoint("-7.5", 64),
+                                 FixedPoint("-4294967296.125", 32), FixedPoint("0.0", 32)};
+    for (const FixedPoint &a : values) {
+        for (const FixedPoint &b : values) {
+            std::string sum = (a + b).to_string(), diff = (a - b).to_string(), prod = (a * b).to_string();
+            EXPECT_EQ((FixedPoint(a) + b).to_string(), sum);
+            EXPECT_EQ((a + FixedPoint(b)).to_string(), sum);
+            EXPECT_EQ((FixedPoint(a) + FixedPoint(b)).to_string(), sum);
+            EXPECT_EQ((FixedPoint(a) - b).to_string(), diff);
+            EXPECT_EQ((a - FixedPoint(b)).to_string(), diff);
+            EXPECT_EQ((FixedPoint(a) - FixedPoint(b)).to_string(), diff);
+            EXPECT_EQ((FixedPoint(a) * b).to_string(), prod);
+            EXPECT_EQ((a * FixedPoint(b)).to_string(), prod);
+            if (!(b == FixedPoint("0.0", 32))) {
+                EXPECT_EQ((FixedPoint(a) / b).to_string(), (a / b).to_string());
+            }
+        }
+    }
+
+    EXPECT_EQ((FixedPoint("1.5", 32) * 4 - 2).to_string(), "4.0");
+
+    FixedPoint moved("123.25", 32);
+    FixedPoint target(std::move(moved));
+    EXPECT_EQ(target.to_string(), "123.25");
+    moved = std::move(target);
+    EXPECT_EQ(moved.to_string(), "123.25");
+}
+
+/**
+ * @test Тест числа с точностью, заданной при компиляции
+ * @brief Сложение, вычитание, умножение и сравнение StaticFixedPoint совпадают
+ * с FixedPoint, усечённым до той же дробной части
+ * @details Включает constexpr-вычисление, числа разных знаков, равные модули
+ * и преобразование в FixedPoint и обратно.
+ */
+TEST(StaticFixedPointTests, MatchesFixedPoint) {
+    using Fixed256 = StaticFixedPoint<2, 8>;
+    constexpr Fixed256 three = Fixed256(1) + Fixed256(2);
+    constexpr Fixed256 six = three * Fixed256(2) - Fixed256(0);
+    static_assert(six.compare(Fixed256(6)) == 0 && three < six && -six < three, "constexpr arithmetic");
+    EXPECT_EQ(six.to_string(), "6.0");
+
+    std::mt19937 rng(16);
+    std::vector<FixedPoint> values = {FixedPoint("0.0", 256), FixedPoint("-1.5", 256),
+                                      FixedPoint("1.5", 256), FixedPoint("18446744073709551615.999", 256)};
+    for (int i = 0; i < 20; ++i) {
+        std::string digits = std::to_string(rng() % 100000) + "." + std::to_string(rng()) + std::to_string(rng());
+        values.emplace_back((i % 2 ? "-" : "") + digits, 256);
+    }
+
+    auto expect_same = [](const Fixed256 &actual, const FixedPoint &expected, const std::string &what) {
+        EXPECT_EQ(Fixed256(expected).limb_array(), actual.limb_array()) << what;
+        EXPECT_EQ(Fixed256(expected).to_string(), actual.to_string()) << what;
+        EXPECT_EQ(Fixed256(actual.to_fixed_point()).limb_array(), actual.limb_array()) << what;
+    };
+    for (const FixedPoint &a : values) {
+        for (const FixedPoint &b : values) {
+            if ((a * b).to_string().size() > 40) continue;
+            Fixed256 sa(a), sb(b);
+            std::string what = a.to_string() + " " + b.to_string();
+            expect_same(sa + sb, a + b, what);
+            expect_same(sa - sb, a - b, what);
+            expect_same(sa * sb, a * b, what);
+            // Порядок берётся по знаку разности
+            FixedPoint diff = a - b;
+            bool equal = diff == FixedPoint("0.0", 32);
+            EXPECT_EQ(sa == sb, equal) << what;
+            EXPECT_EQ(sa < sb, !equal && diff.to_string()[0] == '-') << what;
+        }
+    }
+
+    EXPECT_THROW(Fixed256(FixedPoint("36893488147419103232.0", 32)), std::overflow_error);
+}
+
+/**
+ * @test Тест совмещённых операций
+ * @brief fma, fmma, fmms и sum_of совпадают с записью через операторы
+ * @details Перебираются числа разных знаков и длин, включая совпадающие
+ * операнды (квадрат) и слагаемые, дающие ноль.
+ */
+TEST_F(FixedPointTest, FusedOperations) {
+    const FixedPoint values[] = {FixedPoint("4294967295.75", 32), FixedPoint("-0.000244140625", 96),
+                                 FixedPoint("-18446744073709551616.5", 64), FixedPoint("3.0", 32),
+                                 FixedPoint("-3.0", 256)};
+    for (const FixedPoint &a : values) {
+        for (const FixedPoint &b : values) {
+            for (const FixedPoint &c : values) {
+                EXPECT_EQ(fma(a, b, c).to_string(), (a * b + c).to_string());
+                EXPECT_EQ(fmma(a, b, c, a).to_string(), (a * b + c * a).to_string());
+                EXPECT_EQ(fmms(a, b, c, c).to_string(), (a * b - c * c).to_string());
+                EXPECT_EQ(sum_of(a, b, c, a).to_string(), (a + b + c + a).to_string());
+            }
+        }
+    }
+
+    FixedPoint one("1.0", 32), three("3.0", 32), minus_two("-2.0", 256);
+    EXPECT_EQ(sum_of(one, minus_two, one).to_string(), (one + minus_two + one).to_string());
+    EXPECT_EQ(fmms(three, three, three, three).to_string(), "0.0");
+    EXPECT_EQ(sum_of(three).to_string(), "3.0");
+}
+
+/**
+ * @test Тест окна лимбов в общем буфере
+ * @brief Сдвиг начала окна и рост в обе стороны не портят значение
+ * @details set_precision отбрасывает младшие лимбы сдвигом окна, после чего
+ * сложение с числом с более длинной дробной и целой частями расширяет окно
+ * вниз и вверх, а копия содержит только лимбы числа.
+ */
+TEST_F(FixedPointTest, LimbWindow) {
+    FixedPoint x("1.0000000001", 128);
+    x.set_precision(32);
+    FixedPoint copy = x;
+    x += FixedPoint("18446744073709551616.00000000000000000001", 128);
+    EXPECT_EQ(x.to_string(), (copy + FixedPoint("18446744073709551616.00000000000000000001", 128)).to_string());
+
+    x -= FixedPoint("18446744073709551616.00000000000000000001", 128);
+    EXPECT_TRUE(x == copy);
+
+    FixedPoint acc("0.0", 32);
+    for (int i = 1; i <= 64; ++i) {
+        acc += FixedPoint(std::to_string(i) + ".5", 32 * (i % 5 + 1));
+        acc -= FixedPoint("0.5", 32);
+    }
+    EXPECT_EQ(acc.to_string(), "2080.0");
+}
+
 /**
  * @test Тест операций сравнения
  * @brief Проверка корректности работы операторов сравнения
@@ -76,6 +870,40 @@ TEST_F(FixedPointTest, Comparison) {
     EXPECT_TRUE(num1 != num2);
 }
 
+/**
+ * @test Тест трёхзначного сравнения
+ * @brief compare и операторы сравнения учитывают знак, а нули разных знаков равны
+ * @details Числа с разной длиной дробной и целой частей, ненормализованные
+ * числа из конструктора и результаты операций упорядочиваются так же, как
+ * их десятичные значения.
+ */
+TEST_F(FixedPointTest, ThreeWayCompare) {
+    // Значения по возрастанию
+    const FixedPoint ordered[] = {
+        FixedPoint("-18446744073709551616.5", 64), FixedPoint("-4294967296.0", 32), FixedPoint("-1.5", 256),
+        FixedPoint("-1.25", 32), FixedPoint("-0.000244140625", 96), FixedPoint("0.0", 128),
+        FixedPoint("0.0000000000000000000000000001", 128), FixedPoint("0.5", 32), FixedPoint("1.25", 256),
+        FixedPoint("1.5", 32), FixedPoint("4294967295.75", 32), FixedPoint("18446744073709551616.5", 64)};
+    const size_t n = sizeof(ordered) / sizeof(ordered[0]);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            int expected = i < j ? -1 : (i > j ? 1 : 0);
+            int actual = ordered[i].compare(ordered[j]);
+            EXPECT_EQ((actual > 0) - (actual < 0), expected) << i << " " << j;
+            EXPECT_EQ(ordered[i] < ordered[j], i < j) << i << " " << j;
+            EXPECT_EQ(ordered[i] <= ordered[j], i <= j) << i << " " << j;
+            EXPECT_EQ(ordered[i] == ordered[j], i == j) << i << " " << j;
+            EXPECT_EQ(ordered[i] > ordered[j], i > j) << i << " " << j;
+        }
+    }
+
+    FixedPoint minus_zero = FixedPoint("-1.5", 32) + FixedPoint("1.5", 256);
+    EXPECT_EQ(minus_zero.to_string(), "-0.0");
+    EXPECT_EQ(minus_zero.compare(FixedPoint("0.0", 32)), 0);
+    EXPECT_FALSE(minus_zero < FixedPoint("0.0", 32));
+    EXPECT_TRUE(FixedPoint("1.5", 256) - FixedPoint("0.25", 32) == FixedPoint("1.25", 64));
+}
+
 /**
  * @test Тест битового сдвига влево
  * @brief Проверка корректности работы оператора <<
@@ -110,6 +938,158 @@ TEST(FixedPointTests, RightShift) {
     EXPECT_EQ(d.to_string(), "0.25");  
 }
 
+/**
+ * @test Тест сдвигов на произвольное число бит
+ * @brief Сдвиг совпадает с умножением и делением на FixedPoint("2.0") n раз
+ * @details Сдвиги на части лимба, ровно на лимб и на несколько лимбов в обе
+ * стороны, отрицательные числа и длинные сдвиги через scale_by_pow2.
+ */
+TEST(FixedPointTests, ShiftMatchesRepeatedScaling) {
+    const FixedPoint values[] = {FixedPoint("3.5", 32), FixedPoint("-0.000244140625", 96),
+                                 FixedPoint("18446744073709551617.75", 64), FixedPoint("0.0", 32),
+                                 FixedPoint("-1.1", 256)};
+    for (const FixedPoint &x : values) {
+        FixedPoint doubled = x, halved = x;
+        for (int n = 1; n <= 70; ++n) {
+            doubled = doubled * FixedPoint("2.0");
+            halved = halved / FixedPoint("2.0");
+            EXPECT_EQ((x << n).to_string(), doubled.to_string()) << x.to_string() << " << " << n;
+            EXPECT_EQ((x >> n).to_string(), halved.to_string()) << x.to_string() << " >> " << n;
+            EXPECT_TRUE((x << -n) == halved);
+        }
+    }
+
+    FixedPoint y("-12345.6789", 128);
+    FixedPoint z = y;
+    z.scale_by_pow2(1000).scale_by_pow2(-1003);
+    EXPECT_TRUE(z == y >> 3);
+    EXPECT_TRUE(((y >> 1000) << 1000) == y);
+}
+
+/**
+ * @test Тест разбора дробной части
+ * @brief Дробь переводится как floor(N * 2^frac_bits / 10^d), как при умножении на 2 по биту
+ * @details Проверяет:
+ * - Двоично-конечные дроби и усечение бесконечных при разной точности
+ * - Длинные дроби, у которых решают цифры далеко за нужной точностью
+ */
+TEST(FixedPointTests, FractionParsing) {
+    EXPECT_EQ(FixedPoint("0.75", 2).to_string(), "0.75");
+    EXPECT_EQ(FixedPoint("0.75", 1).to_string(), "0.5");
+    EXPECT_TRUE(FixedPoint("0.1", 8) == FixedPoint("0.09765625", 8));
+    EXPECT_TRUE(FixedPoint("-2.999", 3) == FixedPoint("-2.875", 3));
+    EXPECT_TRUE(FixedPoint("0.99999999999999999999999", 64) == FixedPoint("0.9999999999999999999457898913757247782996273599565029144287109375", 64));
+
+    // 2^-32 = 0.00000000023283064365386962890625: чуть меньше и чуть больше
+    const std::string two_pow_m32 = "0.00000000023283064365386962890625";
+    const std::string below = "0.00000000023283064365386962890624" + std::string(500, '9');
+    const std::string above = two_pow_m32 + std::string(500, '0') + "1";
+    EXPECT_TRUE(FixedPoint(below, 32) == FixedPoint("0.0", 32));
+    EXPECT_TRUE(FixedPoint(above, 32) == FixedPoint(two_pow_m32, 32));
+    EXPECT_TRUE(FixedPoint(above, 64) == FixedPoint(two_pow_m32, 64));
+
+    std::string long_frac = "3.";
+    for (int i = 0; i < 10000; ++i) long_frac += static_cast<char>('0' + (i * 7 + 3) % 10);
+    FixedPoint x(long_frac, 256);
+    EXPECT_TRUE(x == FixedPoint(long_frac.substr(0, 200), 256));
+}
+
+/**
+ * @test Тест конструкторов из машинных чисел
+ * @brief Целые и double записываются в лимбы напрямую и точно
+ * @details Проверяет:
+ * - Совпадение с разбором строки для целых и двоично-представимых double
+ * - Точное значение double 0.1 и крайние 64- и 128-битные целые
+ * - to_double(): обратное преобразование и округление к ближайшему
+ */
+TEST(FixedPointTests, DirectMachineConstructors) {
+    const char *strings[] = {"16.0", "-2.25", "1048576.75", "0.0", "0.000244140625"};
+    const double doubles[] = {16.0, -2.25, 1048576.75, 0.0, 0.000244140625};
+    for (size_t i = 0; i < 5; ++i) {
+        for (int frac_bits : {0, 1, 32, 33, 256}) {
+            EXPECT_EQ(FixedPoint(doubles[i], frac_bits).to_string(), FixedPoint(strings[i], frac_bits).to_string())
+                << strings[i] << ", " << frac_bits;
+        }
+    }
+    EXPECT_EQ(FixedPoint(7, 64).to_string(), FixedPoint("7.0", 64).to_string());
+
+    FixedPoint tenth(0.1, 128);
+    EXPECT_TRUE(tenth == FixedPoint("0.1000000000000000055511151231257827021181583404541015625", 128));
+    EXPECT_TRUE(FixedPoint(0.1, 8) == FixedPoint("0.09765625", 8));
+
+    EXPECT_EQ(FixedPoint(INT64_MIN, 0).to_string(), "-9223372036854775808.0");
+    EXPECT_EQ(FixedPoint(UINT64_MAX).to_string(), "18446744073709551615.0");
+    EXPECT_EQ(FixedPoint(-(static_cast<__int128>(1) << 100)).to_string(), "-1267650600228229401496703205376.0");
+    EXPECT_EQ((1.5_long).to_string(), "1.5");
+    EXPECT_THROW(FixedPoint(std::numeric_limits<double>::quiet_NaN()), std::invalid_argument);
+
+    for (double d : {1.0, -0.1, 3.141592653589793, 1e300, 4.9e-300, 123456789.123}) {
+        EXPECT_EQ(FixedPoint(d, 2048).to_double(), d);
+    }
+    EXPECT_EQ(FixedPoint("0.1", 256).to_double(), 0.1);
+    EXPECT_EQ(FixedPoint("-2.0", 64).to_double() / 3, (FixedPoint("-2.0", 64) / FixedPoint("3.0", 64)).to_double());
+}
+
+/**
+ * @test Тест преобразований в стиле <charconv>
+ * @brief from_chars и to_chars дают те же значения, что конструктор из строки и to_string
+ * @details Проверяет:
+ * - Остановку разбора на первом лишнем символе и отказ без цифр
+ * - Точный размер из to_chars_size, в том числе при переносе от округления
+ * - Отсутствие обращений к ресурсу памяти для числа из 40 лимбов при CHARS_SCRATCH_BYTES по умолчанию
+ */
+TEST(FixedPointTests, CharsConversion) {
+    for (std::string_view str : {"123.456", "-0.96", "+42", "99.99609375", ".5", "7.", "-12345678901234567890.000123"}) {
+        FixedPoint parsed(1);
+        auto [ptr, ec] = from_chars(str, parsed, 64);
+        EXPECT_EQ(ec, std::errc());
+        EXPECT_EQ(ptr, str.data() + str.size());
+        FixedPoint expected(std::string(str), 64);
+        EXPECT_TRUE(parsed == expected) << str;
+
+        for (int len : {-1, 0, 2, 30}) {
+            std::string text = expected.to_string(len);
+            EXPECT_EQ(to_chars_size(parsed, len), text.size()) << str << " " << len;
+            char buf[64];
+            auto written = to_chars(buf, buf + text.size(), parsed, len);
+            EXPECT_EQ(written.ec, std::errc());
+            EXPECT_EQ(std::string(buf, written.ptr), text);
+            auto short_buf = to_chars(buf, buf + text.size() - 1, parsed, len);
+            EXPECT_EQ(short_buf.ec, std::errc::value_too_large);
+            EXPECT_EQ(short_buf.ptr, buf + text.size() - 1);
+        }
+    }
+
+    FixedPoint value(5);
+    std::string_view partial = "12.5e3";
+    EXPECT_EQ(from_chars(partial, value).ptr, partial.data() + 4);
+    EXPECT_EQ(value.to_string(), "12.5");
+    for (std::string_view bad : {"", "abc", "-", ".", "+.e"}) {
+        auto result = from_chars(bad, value);
+        EXPECT_EQ(result.ec, std::errc::invalid_argument) << bad;
+        EXPECT_EQ(result.ptr, bad.data());
+    }
+    EXPECT_EQ(value.to_string(), "12.5");
+
+    std::string digits = "271828182845904523536028747135." + std::string(300, '7');
+    FixedPoint mid(0);
+    from_chars(digits, mid, 1024);
+    std::string expected = mid.to_string();
+    char text[512];
+    CountingResource counting;
+    {
+        LimbResourceScope scope(&counting);
+        EXPECT_EQ(from_chars(digits, mid, 1024).ec, std::errc());
+        auto written = to_chars(text, text + sizeof(text), mid);
+        ASSERT_EQ(written.ec, std::errc());
+        EXPECT_EQ(std::string(text, written.ptr), expected);
+    }
+    // 32 лимба дроби помещаются в массив на стеке при размере по умолчанию
+    if (CHARS_SCRATCH_BYTES >= 16 * 1024) {
+        EXPECT_EQ(counting.allocations, 0u);
+    }
+}
+
 /**
  * @test Тест деления с остатком
  * @brief Проверка корректности divide_with_remainder()